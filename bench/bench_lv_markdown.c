@@ -0,0 +1,485 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file bench_lv_markdown.c
+ * @brief Render and draw benchmarks for lv_markdown
+ *
+ * Runs against a real LVGL software renderer with a dummy flush, so the
+ * numbers cover layout + drawing but not display transfer.
+ *
+ * Usage:
+ *   make bench LVGL_PATH=/path/to/lvgl
+ *   make bench-scaling LVGL_PATH=/path/to/lvgl     (scroll only, 1/2/4 draw threads)
+ *   make bench-huge LVGL_PATH=/path/to/lvgl        (huge-document mode, 256 MB)
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "lvgl.h"
+#include "lv_markdown.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* --- Harness --- */
+
+#define BENCH_HOR_RES   800
+#define BENCH_VER_RES   480
+#define BENCH_FRAMES    200
+
+static uint8_t bench_buf[BENCH_HOR_RES * BENCH_VER_RES * 4];
+
+static void dummy_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
+    (void)area;
+    (void)px_map;
+    lv_display_flush_ready(disp);
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+typedef struct {
+    uint64_t min_ns;
+    uint64_t max_ns;
+    uint64_t total_ns;
+    uint32_t frames;
+} bench_frame_stats_t;
+
+/**
+ * Redraw the whole screen `frames` times and collect per-frame timings.
+ */
+static void bench_draw_frames(lv_display_t * disp, uint32_t frames, bench_frame_stats_t * st)
+{
+    memset(st, 0, sizeof(*st));
+    st->min_ns = UINT64_MAX;
+
+    /* Warm-up frame: layout, glyph cache */
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(disp);
+
+    for(uint32_t i = 0; i < frames; i++) {
+        lv_obj_invalidate(lv_screen_active());
+        uint64_t t0 = now_ns();
+        lv_refr_now(disp);
+        uint64_t dt = now_ns() - t0;
+
+        if(dt < st->min_ns) st->min_ns = dt;
+        if(dt > st->max_ns) st->max_ns = dt;
+        st->total_ns += dt;
+    }
+    st->frames = frames;
+}
+
+static size_t mem_used(void)
+{
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+}
+
+static void bench_print_frames(const char * name, const bench_frame_stats_t * st)
+{
+    printf("  %-24s avg %8.1f us   min %8.1f us   max %8.1f us   (%u frames)\n",
+           name,
+           (double)st->total_ns / st->frames / 1000.0,
+           (double)st->min_ns / 1000.0,
+           (double)st->max_ns / 1000.0,
+           (unsigned)st->frames);
+}
+
+/* --- Documents --- */
+
+/* Heavy on the styling the low-cost profile replaces */
+static const char * doc_styled =
+    "# Release Notes\n"
+    "\n"
+    "This release is *mostly* about **performance**. Some paragraphs mix *italic*, "
+    "**bold** and ***both*** in the same line, which is *exactly* the **worst case** "
+    "for a software renderer drawing *underlines* and **letter-spaced** runs.\n"
+    "\n"
+    "> Quoted notes keep their *emphasis* and a **left border**.\n"
+    ">\n"
+    "> > Nested quotes add *another* border.\n"
+    "\n"
+    "```\n"
+    "static void draw(void)\n"
+    "{\n"
+    "    /* rounded corners */\n"
+    "}\n"
+    "```\n"
+    "\n"
+    "- *first* item with **bold**\n"
+    "- *second* item with **bold**\n"
+    "- *third* item with ***both***\n"
+    "\n"
+    "```\n"
+    "make bench\n"
+    "```\n"
+    "\n"
+    "Closing paragraph with *one* more **emphasis** run and `inline code`.\n";
+
+/* Typical chat history: mostly plain, some inline formatting, few blocks */
+static const char * chat_messages[] = {
+    "ok",
+    "See you at 5",
+    "Sounds good, thanks!",
+    "I pushed the fix to the release branch",
+    "Can you check **the logs** again?",
+    "It's in `config.json`",
+    "- milk\n- eggs\n- bread",
+    "Running late, start without me",
+};
+
+#define BENCH_MESSAGES  2000
+
+#if LV_USE_BIDI
+/* Hebrew and Arabic paragraphs with embedded Latin and numbers (UTF-8) */
+#define HE "\xd7\xa9\xd7\x9c\xd7\x95\xd7\x9d \xd7\xa2\xd7\x95\xd7\x9c\xd7\x9d "
+#define AR "\xd9\x85\xd8\xb1\xd8\xad\xd8\xa8\xd8\xa7 \xd8\xa8\xd8\xa7\xd9\x84\xd8\xb9\xd8\xa7\xd9\x84\xd9\x85 "
+static const char * doc_rtl =
+    "# " HE HE "\n"
+    "\n"
+    HE HE "LVGL 9.2 " HE HE HE "**" HE HE "** " HE HE HE HE "(v1.0) " HE HE HE HE HE "\n"
+    "\n"
+    AR AR AR "*" AR AR "* " AR AR "123 " AR AR AR AR AR AR AR AR "\n"
+    "\n"
+    "- " HE HE HE "\n"
+    "- " AR AR AR "\n"
+    "- " HE "mixed " AR "\n"
+    "\n"
+    "> " HE HE HE HE HE HE HE HE HE HE HE HE "\n"
+    "\n"
+    AR AR AR AR AR AR AR AR AR AR AR AR AR AR AR AR "\n";
+#undef HE
+#undef AR
+#endif
+
+/* --- Benchmarks --- */
+
+static void bench_draw_profiles(lv_display_t * disp)
+{
+    static const struct {
+        lv_markdown_draw_profile_t profile;
+        const char * name;
+    } profiles[] = {
+        { LV_MARKDOWN_DRAW_PROFILE_DEFAULT,  "profile DEFAULT" },
+        { LV_MARKDOWN_DRAW_PROFILE_LOW_COST, "profile LOW_COST" },
+    };
+
+    printf("Draw profiles (%dx%d, full-screen redraw per frame)\n", BENCH_HOR_RES, BENCH_VER_RES);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+    /* Translucent borders so the DEFAULT profile exercises blending */
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    style.blockquote_border_opa = LV_OPA_50;
+    lv_markdown_set_style(md, &style);
+
+    lv_markdown_set_text_static(md, doc_styled);
+
+    for(size_t i = 0; i < sizeof(profiles) / sizeof(profiles[0]); i++) {
+        bench_frame_stats_t st;
+        lv_markdown_set_draw_profile(md, profiles[i].profile);
+        bench_draw_frames(disp, BENCH_FRAMES, &st);
+        bench_print_frames(profiles[i].name, &st);
+    }
+
+    lv_obj_delete(md);
+}
+
+/**
+ * Scroll a long document a few pixels per frame. Every frame redraws the
+ * whole view, like a fling on a real device. Run by bench-scaling with
+ * 1, 2 and 4 software draw threads.
+ */
+static void bench_scroll(lv_display_t * disp)
+{
+    static const struct {
+        lv_markdown_draw_profile_t profile;
+        const char * name;
+    } profiles[] = {
+        { LV_MARKDOWN_DRAW_PROFILE_DEFAULT,  "scroll DEFAULT" },
+        { LV_MARKDOWN_DRAW_PROFILE_LOW_COST, "scroll LOW_COST" },
+    };
+
+    printf("Scroll (%dx%d, %d draw thread%s, 8 px per frame)\n", BENCH_HOR_RES, BENCH_VER_RES,
+           BENCH_DRAW_THREADS, BENCH_DRAW_THREADS > 1 ? "s" : "");
+
+    /* About ten screens of content */
+    static char doc[8 * 1024];
+    size_t len = 0;
+    size_t part = strlen(doc_styled);
+    while(len + part + 2 < sizeof(doc)) {
+        memcpy(doc + len, doc_styled, part);
+        len += part;
+        doc[len++] = '\n';
+        doc[len++] = '\n';
+    }
+    doc[len] = '\0';
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_t * md = lv_markdown_create(scr);
+    lv_markdown_set_text_static(md, doc);
+
+    for(size_t i = 0; i < sizeof(profiles) / sizeof(profiles[0]); i++) {
+        lv_markdown_set_draw_profile(md, profiles[i].profile);
+        lv_obj_scroll_to_y(scr, 0, LV_ANIM_OFF);
+        lv_refr_now(disp);
+
+        bench_frame_stats_t st;
+        memset(&st, 0, sizeof(st));
+        st.min_ns = UINT64_MAX;
+        for(uint32_t f = 0; f < BENCH_FRAMES; f++) {
+            if(lv_obj_get_scroll_bottom(scr) <= 0) lv_obj_scroll_to_y(scr, 0, LV_ANIM_OFF);
+            else lv_obj_scroll_by(scr, 0, -8, LV_ANIM_OFF);
+
+            uint64_t t0 = now_ns();
+            lv_refr_now(disp);
+            uint64_t dt = now_ns() - t0;
+
+            if(dt < st.min_ns) st.min_ns = dt;
+            if(dt > st.max_ns) st.max_ns = dt;
+            st.total_ns += dt;
+        }
+        st.frames = BENCH_FRAMES;
+        bench_print_frames(profiles[i].name, &st);
+    }
+
+    lv_obj_delete(md);
+}
+
+/**
+ * Huge-document mode on a generated report of `mb` megabytes: index time,
+ * heap held by the index and the window, jump and slide times. The text
+ * itself is outside the LVGL heap, as an mmap'd file would be.
+ */
+static void bench_huge(lv_display_t * disp, uint32_t mb)
+{
+    printf("Huge document (%u MB, %u sections shown)\n", (unsigned)mb, (unsigned)LV_MARKDOWN_HUGE_WINDOW);
+
+    size_t size = (size_t)mb * 1024 * 1024;
+    char * doc = malloc(size + 1);
+    if(doc == NULL) {
+        printf("  out of memory\n");
+        return;
+    }
+
+    /* Styled sections with a fenced code block each, as in a generated report */
+    static const char code[] = "```\nstatus: ok\n\nelapsed: 12 ms\n```\n\n";
+    size_t len = 0;
+    size_t part = strlen(doc_styled);
+    while(len + part + sizeof(code) + 2 < size) {
+        memcpy(doc + len, doc_styled, part);
+        len += part;
+        doc[len++] = '\n';
+        doc[len++] = '\n';
+        memcpy(doc + len, code, sizeof(code) - 1);
+        len += sizeof(code) - 1;
+    }
+    doc[len] = '\0';
+
+    lv_obj_t * scr = lv_screen_active();
+    lv_obj_t * md = lv_markdown_create(scr);
+    size_t mem_before = mem_used();
+
+    uint64_t t0 = now_ns();
+    if(lv_markdown_set_text_huge(md, doc, len, 1000) != LV_RESULT_OK) {
+        printf("  lv_markdown_set_text_huge failed\n");
+        lv_obj_delete(md);
+        free(doc);
+        return;
+    }
+    uint64_t t_index = now_ns() - t0;
+
+    t0 = now_ns();
+    lv_refr_now(disp);
+    uint64_t t_frame = now_ns() - t0;
+
+    uint64_t lines = lv_markdown_huge_get_line_count(md);
+    printf("  %-24s %8.1f ms   (%llu lines, %u marks)\n", "index + window", (double)t_index / 1e6,
+           (unsigned long long)lines, (unsigned)lv_markdown_huge_get_mark_count(md));
+    printf("  %-24s %8.1f ms\n", "first frame", (double)t_frame / 1e6);
+    printf("  %-24s %8zu bytes\n", "heap held", mem_used() - mem_before);
+
+    t0 = now_ns();
+    lv_markdown_huge_show_line(md, lines / 2);
+    lv_refr_now(disp);
+    printf("  %-24s %8.1f ms\n", "jump to middle", (double)(now_ns() - t0) / 1e6);
+
+    /* Scroll to the end of the window: the next section slides in */
+    uint64_t first = lv_markdown_huge_get_first_line(md);
+    t0 = now_ns();
+    lv_obj_scroll_to_y(scr, lv_obj_get_scroll_y(scr) + lv_obj_get_scroll_bottom(scr), LV_ANIM_OFF);
+    lv_refr_now(disp);
+    printf("  %-24s %8.1f ms   (first line %llu -> %llu)\n", "slide one section", (double)(now_ns() - t0) / 1e6,
+           (unsigned long long)first, (unsigned long long)lv_markdown_huge_get_first_line(md));
+    printf("  %-24s %8zu bytes\n", "heap held", mem_used() - mem_before);
+
+    lv_obj_delete(md);
+    free(doc);
+}
+
+#if LV_USE_BIDI
+/**
+ * Re-wrap every frame by alternating the widget width, so each frame pays
+ * for layout and for drawing freshly split line pieces.
+ */
+static void bench_bidi_relayout_one(lv_display_t * disp, lv_obj_t * md, const char * name)
+{
+    bench_frame_stats_t st;
+    memset(&st, 0, sizeof(st));
+    st.min_ns = UINT64_MAX;
+
+    lv_refr_now(disp);
+
+    for(uint32_t i = 0; i < BENCH_FRAMES; i++) {
+        lv_obj_set_width(md, (i & 1) ? LV_PCT(90) : LV_PCT(100));
+        uint64_t t0 = now_ns();
+        lv_refr_now(disp);
+        uint64_t dt = now_ns() - t0;
+
+        if(dt < st.min_ns) st.min_ns = dt;
+        if(dt > st.max_ns) st.max_ns = dt;
+        st.total_ns += dt;
+    }
+    st.frames = BENCH_FRAMES;
+
+    bench_print_frames(name, &st);
+}
+
+static void bench_bidi_relayout(lv_display_t * disp)
+{
+    printf("RTL relayout (width toggles every frame, layout + redraw)\n");
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text_static(md, doc_rtl);
+
+    lv_markdown_set_bidi_cache(md, false);
+    bench_bidi_relayout_one(disp, md, "bidi cache off");
+    lv_markdown_set_bidi_cache(md, true);
+    bench_bidi_relayout_one(disp, md, "bidi cache on");
+
+    lv_obj_delete(md);
+}
+#endif
+
+#if LV_USE_SNAPSHOT
+#define BENCH_BATCH_DOCS 500
+
+static void bench_batch(void)
+{
+    printf("Batch thumbnails (offscreen, one recycled tree and buffer)\n");
+
+    /* Cycle a mix of long and short documents */
+    static const char * docs[BENCH_BATCH_DOCS];
+    const size_t msg_cnt = sizeof(chat_messages) / sizeof(chat_messages[0]);
+    for(uint32_t i = 0; i < BENCH_BATCH_DOCS; i++) {
+        docs[i] = (i % 4 == 0) ? doc_styled : chat_messages[i % msg_cnt];
+    }
+
+    static const struct {
+        int32_t w;
+        int32_t h;
+        const char * name;
+    } sizes[] = {
+        { 160, 120, "160x120 RGB565" },
+        { 320, 240, "320x240 RGB565" },
+    };
+
+    for(size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        lv_markdown_batch_t * batch = lv_markdown_batch_create(NULL, sizes[i].w, sizes[i].h,
+                                                               LV_COLOR_FORMAT_RGB565);
+        uint64_t t0 = now_ns();
+        uint32_t ok = lv_markdown_batch_render_list(batch, docs, BENCH_BATCH_DOCS, NULL, NULL);
+        uint64_t dt = now_ns() - t0;
+
+        printf("  %-24s %8.1f docs/s   %8.1f us/doc   (%u docs)\n",
+               sizes[i].name,
+               (double)ok * 1e9 / (double)dt,
+               (double)dt / ok / 1000.0,
+               (unsigned)ok);
+
+        lv_markdown_batch_delete(batch);
+    }
+}
+#endif
+
+typedef lv_obj_t * (*msg_create_fn)(lv_obj_t * parent);
+typedef void (*msg_set_text_fn)(lv_obj_t * obj, const char * text);
+
+static void bench_message_list_one(const char * name, msg_create_fn create, msg_set_text_fn set_text)
+{
+    lv_obj_t * list = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(list);
+    lv_obj_set_size(list, LV_PCT(100), LV_PCT(100));
+    lv_obj_set_flex_flow(list, LV_FLEX_FLOW_COLUMN);
+
+    size_t mem_before = mem_used();
+    uint64_t t0 = now_ns();
+
+    const size_t msg_cnt = sizeof(chat_messages) / sizeof(chat_messages[0]);
+    for(uint32_t i = 0; i < BENCH_MESSAGES; i++) {
+        lv_obj_t * msg = create(list);
+        set_text(msg, chat_messages[i % msg_cnt]);
+    }
+
+    uint64_t dt = now_ns() - t0;
+    size_t mem_after = mem_used();
+
+    printf("  %-24s %6zu bytes/msg   %8.2f us/msg   (%u msgs)\n",
+           name,
+           (mem_after - mem_before) / BENCH_MESSAGES,
+           (double)dt / BENCH_MESSAGES / 1000.0,
+           (unsigned)BENCH_MESSAGES);
+
+    lv_obj_delete(list);
+}
+
+static void bench_message_list(void)
+{
+    printf("Message list (heap bytes incl. LVGL objects, create + set_text time)\n");
+
+    bench_message_list_one("lv_markdown", lv_markdown_create, lv_markdown_set_text);
+    bench_message_list_one("lv_markdown_msg", lv_markdown_msg_create, lv_markdown_msg_set_text);
+}
+
+int main(int argc, char ** argv)
+{
+    lv_init();
+
+    lv_display_t * disp = lv_display_create(BENCH_HOR_RES, BENCH_VER_RES);
+    lv_display_set_flush_cb(disp, dummy_flush);
+    lv_display_set_buffers(disp, bench_buf, NULL, sizeof(bench_buf), LV_DISPLAY_RENDER_MODE_DIRECT);
+
+    if(argc > 1 && strcmp(argv[1], "--huge") == 0) {
+        bench_huge(disp, argc > 2 ? (uint32_t)strtoul(argv[2], NULL, 10) : 256);
+        lv_deinit();
+        return 0;
+    }
+
+    bench_scroll(disp);
+    if(argc > 1 && strcmp(argv[1], "--scroll") == 0) {
+        lv_deinit();
+        return 0;
+    }
+
+    bench_draw_profiles(disp);
+    bench_message_list();
+#if LV_USE_BIDI
+    bench_bidi_relayout(disp);
+#endif
+#if LV_USE_SNAPSHOT
+    bench_batch();
+#endif
+
+    lv_deinit();
+    return 0;
+}
@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file bench_md4c_alloc.h
+ * @brief Count md4c's allocations in the parser microbenchmark
+ *
+ * Included by md4c.c when built for bench_md4c with
+ *   -DMD4C_ALLOC_HEADER='"bench_md4c_alloc.h"'
+ * Not for use elsewhere.
+ */
+
+#ifndef BENCH_MD4C_ALLOC_H
+#define BENCH_MD4C_ALLOC_H
+
+#include <stddef.h>
+
+void * bench_md4c_malloc(size_t size);
+void * bench_md4c_realloc(void * p, size_t size);
+void bench_md4c_free(void * p);
+
+#define malloc(size)        bench_md4c_malloc(size)
+#define realloc(p, size)    bench_md4c_realloc(p, size)
+#define free(p)             bench_md4c_free(p)
+
+#endif /* BENCH_MD4C_ALLOC_H */
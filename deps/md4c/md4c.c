@@ -31,6 +31,11 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* lv_markdown: optional header redirecting malloc/realloc/free (e.g. to lv_malloc) */
+#ifdef MD4C_ALLOC_HEADER
+    #include MD4C_ALLOC_HEADER
+#endif
+
 
 /*****************************
  ***  Miscellaneous Stuff  ***
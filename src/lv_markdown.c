@@ -1,26 +1,19 @@
 /* SPDX-License-Identifier: MIT */
 
 #include "lv_markdown.h"
+#include "lv_markdown_private.h"
+#include "lv_markdown_trace.h"
 #include "md4c.h"
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 
-/* --- Internal data --- */
-
-typedef struct {
-    char *                 text;        /**< Owned copy of markdown text (NULL if static) */
-    const char *           text_ptr;    /**< Pointer to current text (owned or static) */
-    uint8_t                is_static;   /**< 1 if text_ptr points to caller-owned memory */
-    lv_markdown_style_t    style;       /**< Rendering style config */
-    uint32_t               block_count; /**< Number of top-level blocks */
-} lv_markdown_data_t;
-
 /* --- Inline formatting flags (can be combined) --- */
 
 #define MD_FMT_BOLD   (1 << 0)
 #define MD_FMT_ITALIC (1 << 1)
 #define MD_FMT_CODE   (1 << 2)
+#define MD_FMT_STRIKE (1 << 3)
 
 /* --- List nesting state --- */
 
@@ -32,11 +25,21 @@ typedef struct {
     uint32_t counter;      /**< Current item number for ordered lists */
 } md_list_level_t;
 
+/* --- Preview limits --- */
+
+/* Limits of one render (see lv_markdown_set_preview_limits) */
+typedef struct {
+    uint32_t max_blocks;    /**< Top-level blocks, 0 = no limit */
+    uint32_t max_chars;     /**< Characters of text, 0 = no limit */
+    bool     truncated;     /**< Out: the document was cut short */
+} md_preview_t;
+
 /* --- md4c renderer state --- */
 
 typedef struct {
     lv_obj_t *             widget;        /**< The markdown widget (root container) */
-    lv_markdown_data_t *   data;          /**< Widget data */
+    const lv_markdown_style_t * style;    /**< Rendering style config (not owned) */
+    lv_markdown_draw_profile_t draw_profile; /**< Active draw-cost profile */
     lv_obj_t *             cur_span;      /**< Current spangroup being built */
     lv_obj_t *             cur_container; /**< Current parent for new blocks (widget or blockquote) */
     uint32_t               block_count;   /**< Running count of top-level blocks */
@@ -47,12 +50,24 @@ typedef struct {
     md_list_level_t        list_stack[MD_LIST_MAX_DEPTH];
     int                    list_depth;        /**< Current list nesting depth (0 = not in list) */
     uint8_t                li_first_paragraph; /**< 1 if next P inside LI should get bullet/number prefix */
+    char                   li_task_mark;       /**< Task mark of the current item (' ', 'x', 'X'), 0 = not a task */
 
     /* Code block state */
     uint8_t                in_code_block;  /**< 1 when inside MD_BLOCK_CODE */
     char *                 code_buf;       /**< Buffer for accumulating code block text */
     uint32_t               code_buf_len;   /**< Current length of code buffer */
     uint32_t               code_buf_cap;   /**< Allocated capacity of code buffer */
+
+    lv_markdown_arena_t *  arena;          /**< Where span text goes, NULL = spans keep their own copies */
+
+    /* Preview state */
+    md_preview_t *         preview;        /**< Limits, NULL = whole document */
+    uint32_t               chars;          /**< Characters of text so far */
+    uint8_t                preview_full;   /**< 1 = out of characters, stop after this block */
+
+#if LV_USE_BIDI
+    lv_markdown_bidi_cache_t * bidi_cache; /**< Cache for spangroups with non-ASCII text, NULL = none */
+#endif
 } md_render_ctx_t;
 
 /* --- Code block buffer helper --- */
@@ -84,8 +99,61 @@ static void code_buf_append(md_render_ctx_t * ctx, const char * text, uint32_t l
 
 /* --- Inline formatting helper --- */
 
+static inline int is_low_cost(const md_render_ctx_t * ctx)
+{
+    return ctx->draw_profile == LV_MARKDOWN_DRAW_PROFILE_LOW_COST;
+}
+
 /**
- * Apply inline formatting styles to a span based on the active fmt_flags.
+ * Faux bold: letter spacing, or a plain color change under the low-cost
+ * profile (letter-spaced glyphs are placed one by one by the renderer).
+ */
+static void apply_faux_bold(lv_style_t * style, md_render_ctx_t * ctx)
+{
+    if(is_low_cost(ctx)) {
+        lv_style_set_text_color(style, ctx->style->faux_bold_color);
+    }
+    else {
+        lv_style_set_text_letter_space(style, 2);
+    }
+}
+
+/**
+ * Faux italic: underline decoration, or a plain color change under the
+ * low-cost profile (each underline is an extra line draw per span).
+ */
+static void apply_faux_italic(lv_style_t * style, md_render_ctx_t * ctx)
+{
+    if(is_low_cost(ctx)) {
+        lv_style_set_text_color(style, ctx->style->faux_italic_color);
+    }
+    else {
+        lv_style_set_text_decor(style, LV_TEXT_DECOR_UNDERLINE);
+    }
+}
+
+/**
+ * Set a span's font and record its role, so zoom can swap it.
+ */
+static void set_span_font(lv_style_t * style, const lv_font_t * font, lv_markdown_font_role_t role)
+{
+    lv_style_value_t v = {.num = (int32_t)role};
+    lv_style_set_text_font(style, font);
+    lv_style_set_prop(style, lv_markdown_font_role_prop(), v);
+}
+
+/**
+ * Set a block's font and record its role, so zoom can swap it.
+ */
+static void set_block_font(lv_obj_t * obj, const lv_font_t * font, lv_markdown_font_role_t role)
+{
+    lv_style_value_t v = {.num = (int32_t)role};
+    lv_obj_set_style_text_font(obj, font, 0);
+    lv_obj_set_local_style_prop(obj, lv_markdown_font_role_prop(), v, 0);
+}
+
+/**
+ * Apply the font part of the active fmt_flags to a span's style.
  *
  * Font selection priority:
  *   - BOLD+ITALIC: bold_italic_font > bold_font > italic_font > fallbacks
@@ -95,17 +163,17 @@ static void code_buf_append(md_render_ctx_t * ctx, const char * text, uint32_t l
  *
  * Fallback note: LVGL spangroups do not support per-span shadow styles,
  * so faux-bold uses increased letter_space (+1) instead of text shadow.
+ * Under LV_MARKDOWN_DRAW_PROFILE_LOW_COST both fallbacks become colors.
  */
-static void apply_span_formatting(lv_span_t * span, md_render_ctx_t * ctx)
+static void apply_span_fonts(lv_style_t * style, md_render_ctx_t * ctx)
 {
-    const lv_markdown_style_t * s = &ctx->data->style;
+    const lv_markdown_style_t * s = ctx->style;
     uint8_t flags = ctx->fmt_flags;
-    lv_style_t * style = lv_span_get_style(span);
 
     if(flags & MD_FMT_CODE) {
         /* Inline code: font + color. Code suppresses bold/italic per markdown spec. */
         const lv_font_t * font = s->code_font ? s->code_font : s->body_font;
-        lv_style_set_text_font(style, font);
+        set_span_font(style, font, LV_MARKDOWN_FONT_CODE);
         lv_style_set_text_color(style, s->code_color);
         /* code_bg_color is a documented limitation: LVGL spangroups
          * don't support per-span backgrounds, so skip it. */
@@ -118,68 +186,144 @@ static void apply_span_formatting(lv_span_t * span, md_render_ctx_t * ctx)
     if(is_bold && is_italic) {
         /* Bold+Italic: try dedicated font first */
         if(s->bold_italic_font != NULL) {
-            lv_style_set_text_font(style, s->bold_italic_font);
+            set_span_font(style, s->bold_italic_font, LV_MARKDOWN_FONT_BOLD_ITALIC);
             return;
         }
         /* Try bold font with italic fallback */
         if(s->bold_font != NULL) {
-            lv_style_set_text_font(style, s->bold_font);
-            lv_style_set_text_decor(style, LV_TEXT_DECOR_UNDERLINE);
+            set_span_font(style, s->bold_font, LV_MARKDOWN_FONT_BOLD);
+            apply_faux_italic(style, ctx);
             return;
         }
         /* Try italic font with bold fallback */
         if(s->italic_font != NULL) {
-            lv_style_set_text_font(style, s->italic_font);
-            lv_style_set_text_letter_space(style, 2);
+            set_span_font(style, s->italic_font, LV_MARKDOWN_FONT_ITALIC);
+            apply_faux_bold(style, ctx);
             return;
         }
-        /* All NULL: combine both fallbacks */
-        lv_style_set_text_letter_space(style, 2);
-        lv_style_set_text_decor(style, LV_TEXT_DECOR_UNDERLINE);
+        /* All NULL: combine both fallbacks (low-cost: bold color wins) */
+        if(!is_low_cost(ctx)) apply_faux_italic(style, ctx);
+        apply_faux_bold(style, ctx);
         return;
     }
 
     if(is_bold) {
         if(s->bold_font != NULL) {
-            lv_style_set_text_font(style, s->bold_font);
+            set_span_font(style, s->bold_font, LV_MARKDOWN_FONT_BOLD);
         }
         else {
-            /* Faux bold via letter spacing (+2px) */
-            lv_style_set_text_letter_space(style, 2);
+            apply_faux_bold(style, ctx);
         }
         return;
     }
 
     if(is_italic) {
         if(s->italic_font != NULL) {
-            lv_style_set_text_font(style, s->italic_font);
+            set_span_font(style, s->italic_font, LV_MARKDOWN_FONT_ITALIC);
         }
         else {
-            /* Italic fallback via underline decoration */
-            lv_style_set_text_decor(style, LV_TEXT_DECOR_UNDERLINE);
+            apply_faux_italic(style, ctx);
         }
         return;
     }
 }
 
+/**
+ * Apply inline formatting styles to a span based on the active fmt_flags.
+ *
+ * Strikethrough is OR'd into the span's one text_decor property (it may
+ * already hold the faux-italic underline), so struck text costs no extra
+ * style property or object. It is kept under the low-cost profile: unlike
+ * the emphasis fallbacks it carries meaning.
+ */
+static void apply_span_formatting(lv_span_t * span, md_render_ctx_t * ctx)
+{
+    lv_style_t * style = lv_span_get_style(span);
+
+    if(ctx->fmt_flags & (MD_FMT_BOLD | MD_FMT_ITALIC | MD_FMT_CODE)) {
+        apply_span_fonts(style, ctx);
+    }
+
+    if(ctx->fmt_flags & MD_FMT_STRIKE) {
+        lv_style_value_t v;
+        int32_t decor = LV_TEXT_DECOR_STRIKETHROUGH;
+        if(lv_style_get_prop(style, LV_STYLE_TEXT_DECOR, &v) == LV_STYLE_RES_FOUND) decor |= v.num;
+        lv_style_set_text_decor(style, (lv_text_decor_t)decor);
+    }
+}
+
+/* --- Span text helpers --- */
+
+/**
+ * Set a span's text from md4c's (not NUL-terminated) text. With an arena
+ * the span refers to a copy there; otherwise LVGL keeps its own copy.
+ */
+static void span_set_text(md_render_ctx_t * ctx, lv_span_t * span, const char * text, uint32_t len)
+{
+    char * dst = ctx->arena != NULL ? lv_markdown_arena_alloc(ctx->arena, len + 1) : (char *)lv_malloc(len + 1);
+    if(dst == NULL) return;
+    memcpy(dst, text, len);
+    dst[len] = '\0';
+
+    if(ctx->arena != NULL) {
+        lv_span_set_text_static(span, dst);
+        return;
+    }
+    lv_span_set_text(span, dst);
+    lv_free(dst);
+}
+
+/**
+ * Like span_set_text, for NUL-terminated text.
+ */
+static void span_set_text_z(md_render_ctx_t * ctx, lv_span_t * span, const char * text)
+{
+    if(ctx->arena == NULL) {
+        lv_span_set_text(span, text);
+        return;
+    }
+    span_set_text(ctx, span, text, (uint32_t)strlen(text));
+}
+
 /* --- List prefix helper --- */
 
 /**
  * Prepend a bullet or number prefix span to a spangroup for a list item.
+ * Task items get their checkbox glyph instead, as text in the same
+ * spangroup: a checklist costs no more objects than a plain list.
  */
 static void prepend_list_prefix(lv_obj_t * sg, md_render_ctx_t * ctx, int level_idx)
 {
+    if(ctx->li_task_mark != 0) {
+        const char * glyph = (ctx->li_task_mark == ' ') ? ctx->style->task_unchecked : ctx->style->task_checked;
+        ctx->li_task_mark = 0;
+        if(glyph != NULL) {
+            char buf[32];
+            size_t glen = strlen(glyph);
+            if(glen < sizeof(buf) - 2) {
+                memcpy(buf, glyph, glen);
+                buf[glen] = ' ';
+                buf[glen + 1] = '\0';
+                lv_span_t * prefix = lv_spangroup_add_span(sg);
+                if(prefix != NULL) {
+                    span_set_text_z(ctx, prefix, buf);
+                }
+            }
+        }
+        return;
+    }
+
     if(ctx->list_stack[level_idx].is_ordered) {
         char num_buf[16];
         snprintf(num_buf, sizeof(num_buf), "%u. ",
                  (unsigned)ctx->list_stack[level_idx].counter);
         lv_span_t * prefix = lv_spangroup_add_span(sg);
         if(prefix != NULL) {
-            lv_span_set_text(prefix, num_buf);
+            span_set_text_z(ctx, prefix, num_buf);
         }
     }
     else {
-        const char * bullet = ctx->data->style.list_bullet;
+        const char * bullet = ctx->style->list_bullet;
         if(bullet != NULL) {
             char buf[32];
             size_t blen = strlen(bullet);
@@ -189,7 +333,7 @@ static void prepend_list_prefix(lv_obj_t * sg, md_render_ctx_t * ctx, int level_
                 buf[blen + 1] = '\0';
                 lv_span_t * prefix = lv_spangroup_add_span(sg);
                 if(prefix != NULL) {
-                    lv_span_set_text(prefix, buf);
+                    span_set_text_z(ctx, prefix, buf);
                 }
             }
         }
@@ -203,16 +347,192 @@ static void apply_block_spacing(lv_obj_t * block, md_render_ctx_t * ctx)
     /* Use the block's actual parent to check sibling count (works for blockquote children too) */
     lv_obj_t * parent = lv_obj_get_parent(block);
     if(lv_obj_get_child_count(parent) > 1) {
-        lv_obj_set_style_margin_top(block, ctx->data->style.paragraph_spacing, 0);
+        lv_obj_set_style_margin_top(block, ctx->style->paragraph_spacing, 0);
+    }
+}
+
+/* --- Code block helper --- */
+
+/**
+ * Default code block: a padded, rounded container with one label holding
+ * the accumulated text.
+ */
+static void render_code_block(md_render_ctx_t * ctx)
+{
+    const lv_markdown_style_t * s = ctx->style;
+
+    lv_obj_t * container = lv_obj_create(ctx->cur_container);
+    lv_obj_remove_style_all(container);
+    lv_obj_set_width(container, LV_PCT(100));
+    lv_obj_set_height(container, LV_SIZE_CONTENT);
+
+    /* Background + corner radius + padding */
+    lv_obj_set_style_bg_color(container, s->code_block_bg_color, 0);
+    lv_obj_set_style_bg_opa(container, LV_OPA_COVER, 0);
+    /* Low-cost: square corners skip the anti-aliased corner masks */
+    lv_obj_set_style_radius(container, is_low_cost(ctx) ? 0 : s->code_block_corner_radius, 0);
+    lv_obj_set_style_pad_all(container, s->code_block_pad, 0);
+
+    apply_block_spacing(container, ctx);
+
+    /* Create label inside the container with accumulated code text
+     * (an allocated buffer means md4c delivered text, even if only a newline) */
+    if(ctx->code_buf != NULL) {
+        lv_obj_t * label = lv_label_create(container);
+        lv_label_set_text(label, ctx->code_buf);
+        lv_obj_set_width(label, LV_PCT(100));
+
+        /* Apply code font + color */
+        const lv_font_t * font = s->code_font ? s->code_font : s->body_font;
+        set_block_font(label, font, LV_MARKDOWN_FONT_CODE);
+        lv_obj_set_style_text_color(label, s->code_color, 0);
+    }
+}
+
+/* --- Tracing --- */
+
+#if LV_MARKDOWN_USE_TRACE
+/* Event names per callback, indexed by MD_BLOCKTYPE (static strings for the tracer) */
+static const char * const trace_enter_names[] = {
+    "enter doc", "enter quote", "enter ul", "enter ol", "enter li", "enter hr", "enter h", "enter code",
+    "enter html", "enter p", "enter table", "enter thead", "enter tbody", "enter tr", "enter th", "enter td",
+};
+static const char * const trace_leave_names[] = {
+    "leave doc", "leave quote", "leave ul", "leave ol", "leave li", "leave hr", "leave h", "leave code",
+    "leave html", "leave p", "leave table", "leave thead", "leave tbody", "leave tr", "leave th", "leave td",
+};
+
+static const char * block_trace_name(MD_BLOCKTYPE type, int leave)
+{
+    if((size_t)type >= sizeof(trace_enter_names) / sizeof(trace_enter_names[0])) return leave ? "leave" : "enter";
+    return leave ? trace_leave_names[type] : trace_enter_names[type];
+}
+#endif
+
+/* --- Preview helpers --- */
+
+/**
+ * Check whether a block about to be entered would add a top-level block.
+ */
+static bool block_is_counted(const md_render_ctx_t * ctx, MD_BLOCKTYPE type)
+{
+    switch(type) {
+        case MD_BLOCK_LI:
+            return ctx->list_depth > 0 && ctx->list_stack[ctx->list_depth - 1].is_tight;
+        case MD_BLOCK_CODE:
+        case MD_BLOCK_QUOTE:
+        case MD_BLOCK_HR:
+            return true;
+        case MD_BLOCK_P:
+        case MD_BLOCK_H:
+            return ctx->cur_container == ctx->widget;
+        default:
+            return false;
     }
 }
 
+/**
+ * Check whether the preview has no room for another block.
+ */
+static bool preview_is_full(const md_render_ctx_t * ctx)
+{
+    const md_preview_t * p = ctx->preview;
+    return (p->max_blocks > 0 && ctx->block_count >= p->max_blocks) ||
+           (p->max_chars > 0 && ctx->chars >= p->max_chars);
+}
+
+/**
+ * Count the characters of a text run against the limit.
+ *
+ * @return  bytes of the run that fit; sets preview_full if it was cut
+ */
+static MD_SIZE preview_fit(md_render_ctx_t * ctx, const MD_CHAR * text, MD_SIZE size)
+{
+    uint32_t max = ctx->preview->max_chars;
+    if(max == 0) return size;
+
+    for(MD_SIZE i = 0; i < size; i++) {
+        /* Continuation bytes belong to the character before them */
+        if(((uint8_t)text[i] & 0xC0) == 0x80) continue;
+        if(ctx->chars == max) {
+            ctx->preview_full = 1;
+            return i;
+        }
+        ctx->chars++;
+    }
+    return size;
+}
+
+/**
+ * Append the ellipsis to the last text of the tree: a span, or the label
+ * of a code block.
+ */
+static void preview_append_ellipsis(md_render_ctx_t * ctx)
+{
+    lv_obj_t * obj = ctx->widget;
+    while(lv_obj_get_child_count(obj) > 0) {
+        obj = lv_obj_get_child(obj, -1);
+        if(lv_obj_check_type(obj, &lv_spangroup_class)) {
+            lv_span_t * span = lv_spangroup_add_span(obj);
+            if(span == NULL) return;
+            span_set_text_z(ctx, span, LV_MARKDOWN_PREVIEW_ELLIPSIS);
+            lv_spangroup_refresh(obj);
+            return;
+        }
+        if(lv_obj_check_type(obj, &lv_label_class)) {
+            lv_label_ins_text(obj, LV_LABEL_POS_LAST, LV_MARKDOWN_PREVIEW_ELLIPSIS);
+            return;
+        }
+    }
+}
+
+/**
+ * Length of the source to parse for a preview: the text that can fill the
+ * limits, to the end of that line. Nothing past it plus one block's worth
+ * is read, so the cost doesn't grow with the document.
+ *
+ * @param more      set if text remains after the returned length
+ */
+static size_t preview_source_len(const char * text, const md_preview_t * preview, bool * more)
+{
+    uint64_t w = UINT64_MAX;
+    if(preview->max_chars > 0) w = (uint64_t)preview->max_chars * LV_MARKDOWN_PREVIEW_BYTES_PER_CHAR;
+    if(preview->max_blocks > 0) w = LV_MIN(w, (uint64_t)preview->max_blocks * LV_MARKDOWN_PREVIEW_BYTES_PER_BLOCK);
+    size_t window = (size_t)LV_MIN(w, (uint64_t)(SIZE_MAX / 2));
+    size_t end = window + LV_MARKDOWN_PREVIEW_BYTES_PER_BLOCK;
+
+    /* Length within reach, without reading past the terminator */
+    size_t limit = 0;
+    while(limit < end && text[limit] != '\0') limit++;
+    if(limit <= window) {
+        *more = false;
+        return limit;
+    }
+
+    const char * nl = (const char *)memchr(text + window, '\n', limit - window);
+    size_t cut = nl != NULL ? (size_t)(nl - text) + 1 : limit;
+
+    /* Don't split a UTF-8 sequence */
+    while(cut > window && ((uint8_t)text[cut] & 0xC0) == 0x80) cut--;
+
+    *more = cut < limit || text[limit] != '\0';
+    return cut;
+}
+
 /* --- md4c callbacks --- */
 
 static int md_enter_block(MD_BLOCKTYPE type, void * detail, void * userdata)
 {
     md_render_ctx_t * ctx = (md_render_ctx_t *)userdata;
 
+    /* Preview: a block that doesn't fit ends the parse */
+    if(ctx->preview != NULL && block_is_counted(ctx, type) && preview_is_full(ctx)) {
+        ctx->preview->truncated = true;
+        return 1;
+    }
+
+    LV_MARKDOWN_TRACE_BEGIN(block_trace_name(type, 0));
+
     ctx->block_depth++;
 
     switch(type) {
@@ -244,18 +564,20 @@ static int md_enter_block(MD_BLOCKTYPE type, void * detail, void * userdata)
         case MD_BLOCK_LI: {
             if(ctx->list_depth > 0) {
                 int level_idx = ctx->list_depth - 1;
+                MD_BLOCK_LI_DETAIL * li = (MD_BLOCK_LI_DETAIL *)detail;
+                ctx->li_task_mark = li->is_task ? li->task_mark : 0;
                 if(ctx->list_stack[level_idx].is_tight) {
                     /* Tight list: md4c skips P blocks, so create spangroup here */
                     ctx->block_count++;
 
                     lv_obj_t * sg = lv_spangroup_create(ctx->cur_container);
                     lv_obj_set_width(sg, LV_PCT(100));
-                    lv_obj_set_style_text_font(sg, ctx->data->style.body_font, 0);
-                    lv_obj_set_style_text_color(sg, ctx->data->style.body_color, 0);
-                    lv_obj_set_style_text_line_space(sg, ctx->data->style.line_spacing, 0);
+                    set_block_font(sg, ctx->style->body_font, LV_MARKDOWN_FONT_BODY);
+                    lv_obj_set_style_text_color(sg, ctx->style->body_color, 0);
+                    lv_obj_set_style_text_line_space(sg, ctx->style->line_spacing, 0);
 
                     /* Apply indentation */
-                    int32_t indent = ctx->data->style.list_indent * ctx->list_depth;
+                    int32_t indent = ctx->style->list_indent * ctx->list_depth;
                     lv_obj_set_style_pad_left(sg, indent, 0);
 
                     /* Add bullet or number prefix */
@@ -283,7 +605,7 @@ static int md_enter_block(MD_BLOCKTYPE type, void * detail, void * userdata)
         case MD_BLOCK_QUOTE: {
             /* Blockquote: create a container with left border and padding */
             ctx->block_count++;
-            const lv_markdown_style_t * s = &ctx->data->style;
+            const lv_markdown_style_t * s = ctx->style;
 
             lv_obj_t * bq = lv_obj_create(ctx->cur_container);
             lv_obj_remove_style_all(bq);
@@ -295,7 +617,8 @@ static int md_enter_block(MD_BLOCKTYPE type, void * detail, void * userdata)
             lv_obj_set_style_border_color(bq, s->blockquote_border_color, 0);
             lv_obj_set_style_border_width(bq, s->blockquote_border_width, 0);
             lv_obj_set_style_border_side(bq, LV_BORDER_SIDE_LEFT, 0);
-            lv_obj_set_style_border_opa(bq, LV_OPA_COVER, 0);
+            /* Low-cost: a blended border costs a read-modify-write per pixel */
+            lv_obj_set_style_border_opa(bq, is_low_cost(ctx) ? LV_OPA_COVER : s->blockquote_border_opa, 0);
 
             /* Left padding */
             lv_obj_set_style_pad_left(bq, s->blockquote_pad_left, 0);
@@ -317,27 +640,29 @@ static int md_enter_block(MD_BLOCKTYPE type, void * detail, void * userdata)
             lv_obj_t * sg = lv_spangroup_create(ctx->cur_container);
             lv_obj_set_width(sg, LV_PCT(100));
 
-            const lv_font_t * font = ctx->data->style.body_font;
-            lv_color_t color = ctx->data->style.body_color;
+            const lv_font_t * font = ctx->style->body_font;
+            lv_markdown_font_role_t role = LV_MARKDOWN_FONT_BODY;
+            lv_color_t color = ctx->style->body_color;
 
             if(type == MD_BLOCK_H) {
                 MD_BLOCK_H_DETAIL * h = (MD_BLOCK_H_DETAIL *)detail;
                 int level = h->level - 1; /* 0-indexed */
                 if(level >= 0 && level < 6) {
-                    if(ctx->data->style.heading_font[level] != NULL) {
-                        font = ctx->data->style.heading_font[level];
+                    role = (lv_markdown_font_role_t)(LV_MARKDOWN_FONT_H1 + level);
+                    if(ctx->style->heading_font[level] != NULL) {
+                        font = ctx->style->heading_font[level];
                     }
-                    color = ctx->data->style.heading_color[level];
+                    color = ctx->style->heading_color[level];
                 }
             }
 
-            lv_obj_set_style_text_font(sg, font, 0);
+            set_block_font(sg, font, role);
             lv_obj_set_style_text_color(sg, color, 0);
-            lv_obj_set_style_text_line_space(sg, ctx->data->style.line_spacing, 0);
+            lv_obj_set_style_text_line_space(sg, ctx->style->line_spacing, 0);
 
             /* Apply list indentation and bullet/number prefix if inside a list */
             if(ctx->list_depth > 0 && type == MD_BLOCK_P) {
-                int32_t indent = ctx->data->style.list_indent * ctx->list_depth;
+                int32_t indent = ctx->style->list_indent * ctx->list_depth;
                 lv_obj_set_style_pad_left(sg, indent, 0);
 
                 /* Add bullet or number prefix on the first paragraph of a list item */
@@ -354,12 +679,23 @@ static int md_enter_block(MD_BLOCKTYPE type, void * detail, void * userdata)
         }
         case MD_BLOCK_HR: {
             ctx->block_count++;
+
+            const lv_markdown_handler_entry_t * h = lv_markdown_find_block_handler(LV_MARKDOWN_BLOCK_HR, NULL, 0);
+            if(h != NULL) {
+                lv_markdown_block_t block = {
+                    .type = LV_MARKDOWN_BLOCK_HR, .lang = "", .text = "", .text_len = 0, .style = ctx->style,
+                };
+                lv_obj_t * obj = lv_markdown_run_block_handler(ctx->cur_container, h, &block);
+                if(obj != NULL) apply_block_spacing(obj, ctx);
+                break;
+            }
+
             /* Horizontal rule: a thin colored bar */
             lv_obj_t * hr = lv_obj_create(ctx->cur_container);
             lv_obj_remove_style_all(hr);
             lv_obj_set_width(hr, LV_PCT(100));
-            lv_obj_set_height(hr, ctx->data->style.hr_height);
-            lv_obj_set_style_bg_color(hr, ctx->data->style.hr_color, 0);
+            lv_obj_set_height(hr, ctx->style->hr_height);
+            lv_obj_set_style_bg_color(hr, ctx->style->hr_color, 0);
             lv_obj_set_style_bg_opa(hr, LV_OPA_COVER, 0);
 
             apply_block_spacing(hr, ctx);
@@ -369,6 +705,8 @@ static int md_enter_block(MD_BLOCKTYPE type, void * detail, void * userdata)
             break;
     }
 
+    LV_MARKDOWN_TRACE_END(block_trace_name(type, 0));
+
     return 0;
 }
 
@@ -376,7 +714,7 @@ static int md_leave_block(MD_BLOCKTYPE type, void * detail, void * userdata)
 {
     md_render_ctx_t * ctx = (md_render_ctx_t *)userdata;
 
-    (void)detail;
+    LV_MARKDOWN_TRACE_BEGIN(block_trace_name(type, 1));
 
     ctx->block_depth--;
 
@@ -404,38 +742,44 @@ static int md_leave_block(MD_BLOCKTYPE type, void * detail, void * userdata)
             break;
         }
         case MD_BLOCK_CODE: {
-            /* Create code block container with accumulated text */
-            const lv_markdown_style_t * s = &ctx->data->style;
-
-            lv_obj_t * container = lv_obj_create(ctx->cur_container);
-            lv_obj_remove_style_all(container);
-            lv_obj_set_width(container, LV_PCT(100));
-            lv_obj_set_height(container, LV_SIZE_CONTENT);
-
-            /* Background + corner radius + padding */
-            lv_obj_set_style_bg_color(container, s->code_block_bg_color, 0);
-            lv_obj_set_style_bg_opa(container, LV_OPA_COVER, 0);
-            lv_obj_set_style_radius(container, s->code_block_corner_radius, 0);
-            lv_obj_set_style_pad_all(container, s->code_block_pad, 0);
-
-            apply_block_spacing(container, ctx);
-
-            /* Create label inside the container with accumulated code text */
-            if(ctx->code_buf != NULL && ctx->code_buf_len > 0) {
-                /* Strip trailing newline if present (md4c adds one) */
-                if(ctx->code_buf[ctx->code_buf_len - 1] == '\n') {
-                    ctx->code_buf[ctx->code_buf_len - 1] = '\0';
-                    ctx->code_buf_len--;
-                }
-
-                lv_obj_t * label = lv_label_create(container);
-                lv_label_set_text(label, ctx->code_buf);
-                lv_obj_set_width(label, LV_PCT(100));
+            /* Strip trailing newline if present (md4c adds one) */
+            if(ctx->code_buf != NULL && ctx->code_buf_len > 0 && ctx->code_buf[ctx->code_buf_len - 1] == '\n') {
+                ctx->code_buf[ctx->code_buf_len - 1] = '\0';
+                ctx->code_buf_len--;
+            }
 
-                /* Apply code font + color */
-                const lv_font_t * font = s->code_font ? s->code_font : s->body_font;
-                lv_obj_set_style_text_font(label, font, 0);
-                lv_obj_set_style_text_color(label, s->code_color, 0);
+            /* A registered handler (by fence language, or for any code) replaces the default */
+            const MD_BLOCK_CODE_DETAIL * code = (const MD_BLOCK_CODE_DETAIL *)detail;
+            const lv_markdown_handler_entry_t * h =
+                lv_markdown_find_block_handler(LV_MARKDOWN_BLOCK_CODE, code->lang.text, code->lang.size);
+            if(h != NULL) {
+                /* Indented code has no language (lang.text is NULL); long ones go on the heap */
+                char lang_buf[32];
+                char * lang = lang_buf;
+                MD_SIZE lang_len = code->lang.text != NULL ? code->lang.size : 0;
+                if(lang_len >= sizeof(lang_buf)) {
+                    lang = (char *)lv_malloc(lang_len + 1);
+                    if(lang == NULL) {
+                        lang = lang_buf;
+                        lang_len = 0;
+                    }
+                }
+                if(lang_len > 0) memcpy(lang, code->lang.text, lang_len);
+                lang[lang_len] = '\0';
+
+                lv_markdown_block_t block = {
+                    .type     = LV_MARKDOWN_BLOCK_CODE,
+                    .lang     = lang,
+                    .text     = ctx->code_buf != NULL ? ctx->code_buf : "",
+                    .text_len = ctx->code_buf_len,
+                    .style    = ctx->style,
+                };
+                lv_obj_t * obj = lv_markdown_run_block_handler(ctx->cur_container, h, &block);
+                if(obj != NULL) apply_block_spacing(obj, ctx);
+                if(lang != lang_buf) lv_free(lang);
+            }
+            else {
+                render_code_block(ctx);
             }
 
             /* Free code buffer */
@@ -465,7 +809,10 @@ static int md_leave_block(MD_BLOCKTYPE type, void * detail, void * userdata)
             break;
     }
 
-    return 0;
+    LV_MARKDOWN_TRACE_END(block_trace_name(type, 1));
+
+    /* Preview: the block holding the last character is finished */
+    return ctx->preview_full ? 1 : 0;
 }
 
 static int md_enter_span(MD_SPANTYPE type, void * detail, void * userdata)
@@ -484,6 +831,9 @@ static int md_enter_span(MD_SPANTYPE type, void * detail, void * userdata)
         case MD_SPAN_CODE:
             ctx->fmt_flags |= MD_FMT_CODE;
             break;
+        case MD_SPAN_DEL:
+            ctx->fmt_flags |= MD_FMT_STRIKE;
+            break;
         default:
             break;
     }
@@ -507,6 +857,9 @@ static int md_leave_span(MD_SPANTYPE type, void * detail, void * userdata)
         case MD_SPAN_CODE:
             ctx->fmt_flags &= ~MD_FMT_CODE;
             break;
+        case MD_SPAN_DEL:
+            ctx->fmt_flags &= ~MD_FMT_STRIKE;
+            break;
         default:
             break;
     }
@@ -520,6 +873,14 @@ static int md_text(MD_TEXTTYPE type, const MD_CHAR * text, MD_SIZE size, void *
 
     (void)type;
 
+    /* Preview: drop the rest of the block that ran out of characters */
+    if(ctx->preview != NULL) {
+        if(ctx->preview_full) return 0;
+        size = preview_fit(ctx, text, size);
+        if(ctx->preview_full) ctx->preview->truncated = true;
+        if(size == 0) return 0;
+    }
+
     /* Inside a code block: accumulate text into buffer */
     if(ctx->in_code_block) {
         code_buf_append(ctx, text, size);
@@ -528,62 +889,108 @@ static int md_text(MD_TEXTTYPE type, const MD_CHAR * text, MD_SIZE size, void *
 
     if(ctx->cur_span == NULL) return 0;
 
-    lv_span_t * span = lv_spangroup_add_span(ctx->cur_span);
-    if(span == NULL) return 0;
+    LV_MARKDOWN_TRACE_BEGIN("span");
 
-    /* md4c text is not null-terminated, so we need a temporary copy */
-    char * tmp = (char *)lv_malloc(size + 1);
-    if(tmp == NULL) return 0;
-    memcpy(tmp, text, size);
-    tmp[size] = '\0';
+    lv_span_t * span = lv_spangroup_add_span(ctx->cur_span);
+    if(span == NULL) {
+        LV_MARKDOWN_TRACE_END("span");
+        return 0;
+    }
 
-    lv_span_set_text(span, tmp);
-    lv_free(tmp);
+    span_set_text(ctx, span, text, size);
+
+#if LV_USE_BIDI
+    /* Only runs that can contain RTL characters need the draw hook */
+    if(ctx->bidi_cache != NULL && !lv_obj_has_flag(ctx->cur_span, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS)) {
+        for(MD_SIZE i = 0; i < size; i++) {
+            if((uint8_t)text[i] >= 0x80) {
+                lv_obj_add_flag(ctx->cur_span, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+                lv_obj_add_event_cb(ctx->cur_span, lv_markdown_bidi_draw_task_cb, LV_EVENT_DRAW_TASK_ADDED,
+                                    ctx->bidi_cache);
+                break;
+            }
+        }
+    }
+#endif
 
-    /* Apply inline formatting (bold, italic, code) if any flags are active */
+    /* Apply inline formatting (bold, italic, code, strikethrough) if any flags are active */
     if(ctx->fmt_flags != 0) {
         apply_span_formatting(span, ctx);
     }
 
+    LV_MARKDOWN_TRACE_END("span");
     return 0;
 }
 
 /* --- Internal helpers --- */
 
+/**
+ * Count a tree that is dropped before any frame could show it.
+ */
+static void lv_markdown_count_dropped(lv_markdown_data_t * data)
+{
+    if(data->block_count > 0 && data->built_frame == lv_markdown_lazy_get_frame()) {
+        data->stats.discarded++;
+    }
+}
+
 static void lv_markdown_clear(lv_obj_t * obj, lv_markdown_data_t * data)
 {
+    lv_markdown_phase_t prev = lv_markdown_alloc_set_phase(LV_MARKDOWN_PHASE_CLEAR);
+
+    /* A waiting update is replaced without being built */
+    if(data->sched_pending || data->lazy_pending) data->stats.coalesced++;
+    lv_markdown_count_dropped(data);
+
+    lv_markdown_state_reset(obj, data);
     lv_obj_clean(obj);
+    lv_markdown_arena_free(&data->arena);
+    lv_markdown_sched_cancel(obj, data);
+    lv_markdown_lazy_cancel(obj, data);
+    lv_markdown_log_delete(data);
+    lv_markdown_huge_delete(obj, data);
+    lv_markdown_zoom_tree_changed(obj, data);
+#if LV_USE_BIDI
+    lv_markdown_bidi_cache_clear(&data->bidi_cache);
+#endif
 
     if(data->text != NULL) {
         lv_free(data->text);
         data->text = NULL;
     }
-    data->text_ptr    = NULL;
-    data->is_static   = 0;
-    data->block_count = 0;
+    data->text_ptr     = NULL;
+    data->is_static    = 0;
+    data->block_count  = 0;
+    data->preview_truncated = 0;
+    data->utf8_invalid = 0;
+    data->text_ascii   = 0;
+
+    lv_markdown_alloc_set_phase(prev);
 }
 
-static void lv_markdown_render(lv_obj_t * obj, lv_markdown_data_t * data)
+/* Parser callbacks are stateless, so every render shares one parser config */
+static const MD_PARSER md_parser = {
+    .abi_version = 0,
+    .flags       = MD_FLAG_TASKLISTS | MD_FLAG_STRIKETHROUGH,
+    .enter_block = md_enter_block,
+    .leave_block = md_leave_block,
+    .enter_span  = md_enter_span,
+    .leave_span  = md_leave_span,
+    .text        = md_text,
+    .debug_log   = NULL,
+    .syntax      = NULL,
+};
+
+static uint32_t render_blocks(lv_obj_t * container, const lv_markdown_style_t * style,
+                              lv_markdown_draw_profile_t profile, const char * text, size_t len,
+                              lv_markdown_arena_t * arena, void * bidi_cache, md_preview_t * preview)
 {
-    if(data->text_ptr == NULL || data->text_ptr[0] == '\0') return;
-
-    MD_PARSER parser = {
-        .abi_version = 0,
-        .flags       = 0,
-        .enter_block = md_enter_block,
-        .leave_block = md_leave_block,
-        .enter_span  = md_enter_span,
-        .leave_span  = md_leave_span,
-        .text        = md_text,
-        .debug_log   = NULL,
-        .syntax      = NULL,
-    };
-
     md_render_ctx_t ctx = {
-        .widget             = obj,
-        .data               = data,
+        .widget             = container,
+        .style              = style,
+        .draw_profile       = profile,
         .cur_span           = NULL,
-        .cur_container      = obj,
+        .cur_container      = container,
         .block_count        = 0,
         .block_depth        = 0,
         .fmt_flags          = 0,
@@ -594,16 +1001,121 @@ static void lv_markdown_render(lv_obj_t * obj, lv_markdown_data_t * data)
         .code_buf           = NULL,
         .code_buf_len       = 0,
         .code_buf_cap       = 0,
+        .arena              = arena,
+        .preview            = preview,
+        .chars              = 0,
+        .preview_full       = 0,
+#if LV_USE_BIDI
+        .bidi_cache         = bidi_cache,
+#endif
     };
+#if !LV_USE_BIDI
+    (void)bidi_cache;
+#endif
+
+    /* md4c's own buffers are re-attributed to PARSE by lv_markdown_md4c_alloc.h */
+    lv_markdown_phase_t prev = lv_markdown_alloc_set_phase(LV_MARKDOWN_PHASE_BUILD);
 
-    md_parse(data->text_ptr, (MD_SIZE)strlen(data->text_ptr), &parser, &ctx);
+    LV_MARKDOWN_TRACE_BEGIN("md_parse");
+    md_parse(text, (MD_SIZE)len, &md_parser, &ctx);
+    LV_MARKDOWN_TRACE_END("md_parse");
 
     /* Safety: free code buffer if parsing was interrupted mid-block */
     if(ctx.code_buf != NULL) {
         lv_free(ctx.code_buf);
     }
 
-    data->block_count = ctx.block_count;
+    if(preview != NULL && preview->truncated) preview_append_ellipsis(&ctx);
+
+    lv_markdown_alloc_set_phase(prev);
+
+    return ctx.block_count;
+}
+
+uint32_t lv_markdown_render_into(lv_obj_t * container, const lv_markdown_style_t * style,
+                                 lv_markdown_draw_profile_t profile, const char * text, size_t len)
+{
+    return render_blocks(container, style, profile, text, len, NULL, NULL, NULL);
+}
+
+static void lv_markdown_render(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    void * bidi_cache = NULL;
+#if LV_USE_BIDI
+    /* ASCII text has no right-to-left runs to reorder */
+    if(!data->bidi_cache_off && !data->text_ascii) bidi_cache = &data->bidi_cache;
+#endif
+
+    data->preview_truncated = 0;
+    if(data->text_ptr != NULL && data->text_ptr[0] != '\0') {
+        md_preview_t preview = {
+            .max_blocks = data->preview_max_blocks,
+            .max_chars  = data->preview_max_chars,
+            .truncated  = false,
+        };
+        bool limited = preview.max_blocks > 0 || preview.max_chars > 0;
+
+        size_t len;
+        if(limited) len = preview_source_len(data->text_ptr, &preview, &preview.truncated);
+        else len = strlen(data->text_ptr);
+
+        /* Markup dropped from spans about makes up for prefixes and NULs */
+        lv_markdown_arena_reserve(&data->arena, (uint32_t)LV_MIN(len + len / 8 + 64, UINT32_MAX / 2));
+        data->block_count = render_blocks(obj, &data->style, data->draw_profile, data->text_ptr, len,
+                                          &data->arena, bidi_cache, limited ? &preview : NULL);
+        data->preview_truncated = preview.truncated;
+        data->stats.builds++;
+        data->built_frame = lv_markdown_lazy_get_frame();
+    }
+
+    lv_markdown_zoom_tree_changed(obj, data);
+}
+
+/**
+ * Rebuild the widget tree from the current text, e.g. after a style or
+ * profile change. The text itself is kept. With the scheduler on, or for
+ * a lazy widget, the old tree stays until the widget's turn comes.
+ */
+void lv_markdown_rerender(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    data->stats.updates++;
+    if(data->sched_pending || data->lazy_pending) data->stats.coalesced++;
+
+    if(lv_markdown_lazy_defer(obj, data)) return;
+    if(lv_markdown_sched_defer(obj, data)) return;
+    lv_markdown_rebuild(obj, data);
+}
+
+void lv_markdown_build_pending(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(!data->sched_pending && !data->lazy_pending) return;
+
+    lv_markdown_sched_cancel(obj, data);
+    lv_markdown_lazy_cancel(obj, data);
+    lv_markdown_rebuild(obj, data);
+}
+
+void lv_markdown_rebuild(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(data->log != NULL) {
+        lv_markdown_log_rerender(obj, data);
+        return;
+    }
+    if(data->huge != NULL) {
+        lv_markdown_huge_rerender(obj, data);
+        return;
+    }
+    if(data->text_ptr == NULL) return;
+
+    lv_markdown_count_dropped(data);
+    lv_markdown_state_reset(obj, data);
+    lv_markdown_phase_t prev = lv_markdown_alloc_set_phase(LV_MARKDOWN_PHASE_CLEAR);
+    lv_obj_clean(obj);
+    lv_markdown_arena_free(&data->arena);
+    lv_markdown_alloc_set_phase(prev);
+    data->block_count = 0;
+
+    lv_markdown_render(obj, data);
 }
 
 /* --- Cleanup event handler --- */
@@ -613,6 +1125,18 @@ static void lv_markdown_delete_cb(lv_event_t * e)
     lv_obj_t * obj = lv_event_get_target(e);
     lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
     if(data != NULL) {
+        lv_markdown_zoom_reset(obj, data);
+        lv_markdown_log_delete(data);
+        lv_markdown_huge_delete(obj, data);
+        lv_markdown_follow_reset(obj, data);
+        lv_markdown_state_reset(obj, data);
+        lv_markdown_sched_cancel(obj, data);
+        lv_markdown_lazy_cancel(obj, data);
+#if LV_USE_BIDI
+        lv_markdown_bidi_cache_clear(&data->bidi_cache);
+#endif
+        /* The spans are deleted next and don't read their text on the way */
+        lv_markdown_arena_free(&data->arena);
         if(data->text != NULL) {
             lv_free(data->text);
         }
@@ -621,6 +1145,43 @@ static void lv_markdown_delete_cb(lv_event_t * e)
     }
 }
 
+#if LV_USE_BIDI
+static void lv_markdown_size_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data != NULL) lv_markdown_bidi_cache_set_width(&data->bidi_cache, lv_obj_get_width(obj));
+}
+#endif
+
+/* --- Input check --- */
+
+/**
+ * Scan new text according to the UTF-8 policy. With LV_MARKDOWN_UTF8_REPAIR,
+ * invalid text is repaired into an owned copy.
+ *
+ * @return  true if data->text now holds the repaired text
+ */
+static bool lv_markdown_check_utf8(lv_markdown_data_t * data, const char * text, size_t len)
+{
+    if(data->utf8_policy == LV_MARKDOWN_UTF8_OFF) return false;
+
+    lv_markdown_utf8_result_t res;
+    lv_markdown_utf8_scan(text, len, &res);
+    data->utf8_invalid = res.invalid > 0;
+    data->text_ascii   = res.ascii;
+    if(res.invalid == 0 || data->utf8_policy != LV_MARKDOWN_UTF8_REPAIR) return false;
+
+    /* Each replaced subpart is at least one byte and U+FFFD is three */
+    data->text = (char *)lv_malloc(len + 2 * res.invalid + 1);
+    if(data->text == NULL) return false;
+    lv_markdown_utf8_repair(text, len, data->text);
+    data->text_ptr     = data->text;
+    data->is_static    = 0;
+    data->utf8_invalid = 1;
+    return true;
+}
+
 /* --- Public API --- */
 
 lv_obj_t * lv_markdown_create(lv_obj_t * parent)
@@ -646,6 +1207,11 @@ lv_obj_t * lv_markdown_create(lv_obj_t * parent)
 
     /* Register cleanup on delete */
     lv_obj_add_event_cb(obj, lv_markdown_delete_cb, LV_EVENT_DELETE, NULL);
+#if LV_USE_BIDI
+    /* Runs wrapped at another width are flushed */
+    lv_obj_add_event_cb(obj, lv_markdown_size_cb, LV_EVENT_SIZE_CHANGED, NULL);
+#endif
+    lv_markdown_lazy_hook_display(lv_obj_get_display(obj));
 
     return obj;
 }
@@ -655,19 +1221,24 @@ void lv_markdown_set_text(lv_obj_t * obj, const char * text)
     lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
     if(data == NULL) return;
 
+    data->stats.updates++;
     lv_markdown_clear(obj, data);
 
     if(text == NULL) return;
 
-    /* Copy the text */
+    /* Copy the text, repaired if needed */
     size_t len = strlen(text);
-    data->text = (char *)lv_malloc(len + 1);
-    if(data->text == NULL) return;
-    memcpy(data->text, text, len + 1);
-    data->text_ptr  = data->text;
-    data->is_static = 0;
+    if(!lv_markdown_check_utf8(data, text, len)) {
+        data->text = (char *)lv_malloc(len + 1);
+        if(data->text == NULL) return;
+        memcpy(data->text, text, len + 1);
+        data->text_ptr  = data->text;
+        data->is_static = 0;
+    }
 
-    lv_markdown_render(obj, data);
+    if(!lv_markdown_lazy_defer(obj, data) && !lv_markdown_sched_defer(obj, data)) {
+        lv_markdown_render(obj, data);
+    }
 }
 
 void lv_markdown_set_text_static(lv_obj_t * obj, const char * text)
@@ -675,14 +1246,20 @@ void lv_markdown_set_text_static(lv_obj_t * obj, const char * text)
     lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
     if(data == NULL) return;
 
+    data->stats.updates++;
     lv_markdown_clear(obj, data);
 
     if(text == NULL) return;
 
-    data->text_ptr  = text;
-    data->is_static = 1;
+    /* Invalid text is repaired into an owned copy, valid text isn't copied */
+    if(!lv_markdown_check_utf8(data, text, strlen(text))) {
+        data->text_ptr  = text;
+        data->is_static = 1;
+    }
 
-    lv_markdown_render(obj, data);
+    if(!lv_markdown_lazy_defer(obj, data) && !lv_markdown_sched_defer(obj, data)) {
+        lv_markdown_render(obj, data);
+    }
 }
 
 void lv_markdown_set_style(lv_obj_t * obj, const lv_markdown_style_t * style)
@@ -690,25 +1267,77 @@ void lv_markdown_set_style(lv_obj_t * obj, const lv_markdown_style_t * style)
     lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
     if(data == NULL || style == NULL) return;
 
+    /* An explicit style replaces any zoom level set */
+    lv_markdown_zoom_reset(obj, data);
     memcpy(&data->style, style, sizeof(lv_markdown_style_t));
 
     /* Re-render with new style if text is set */
-    if(data->text_ptr != NULL) {
-        const char * saved_ptr = data->text_ptr;
-        uint8_t was_static = data->is_static;
-        char * saved_text = data->text;
+    lv_markdown_rerender(obj, data);
+}
 
-        /* Clear children but preserve text */
-        lv_obj_clean(obj);
-        data->block_count = 0;
+void lv_markdown_set_draw_profile(lv_obj_t * obj, lv_markdown_draw_profile_t profile)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+    if(data->draw_profile == profile) return;
 
-        /* Restore text pointer (clear would free it) */
-        data->text     = saved_text;
-        data->text_ptr = saved_ptr;
-        data->is_static = was_static;
+    data->draw_profile = profile;
+    lv_markdown_rerender(obj, data);
+}
 
-        lv_markdown_render(obj, data);
-    }
+lv_markdown_draw_profile_t lv_markdown_get_draw_profile(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return LV_MARKDOWN_DRAW_PROFILE_DEFAULT;
+
+    return data->draw_profile;
+}
+
+#if LV_USE_BIDI
+void lv_markdown_set_bidi_cache(lv_obj_t * obj, bool en)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+    if(data->bidi_cache_off == !en) return;
+
+    data->bidi_cache_off = !en;
+    lv_markdown_bidi_cache_clear(&data->bidi_cache);
+    lv_markdown_rerender(obj, data);
+}
+#endif
+
+void lv_markdown_set_utf8_policy(lv_obj_t * obj, lv_markdown_utf8_policy_t policy)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    data->utf8_policy = policy;
+}
+
+bool lv_markdown_get_utf8_valid(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return true;
+
+    return !data->utf8_invalid;
+}
+
+void lv_markdown_get_update_stats(lv_obj_t * obj, lv_markdown_update_stats_t * stats)
+{
+    lv_memzero(stats, sizeof(lv_markdown_update_stats_t));
+
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    *stats = data->stats;
+}
+
+void lv_markdown_reset_update_stats(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    lv_memzero(&data->stats, sizeof(lv_markdown_update_stats_t));
 }
 
 const char * lv_markdown_get_text(lv_obj_t * obj)
@@ -719,6 +1348,25 @@ const char * lv_markdown_get_text(lv_obj_t * obj)
     return data->text_ptr;
 }
 
+void lv_markdown_set_preview_limits(lv_obj_t * obj, uint32_t max_blocks, uint32_t max_chars)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+    if(data->preview_max_blocks == max_blocks && data->preview_max_chars == max_chars) return;
+
+    data->preview_max_blocks = max_blocks;
+    data->preview_max_chars  = max_chars;
+    lv_markdown_rerender(obj, data);
+}
+
+bool lv_markdown_get_preview_truncated(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return false;
+
+    return data->preview_truncated;
+}
+
 uint32_t lv_markdown_get_block_count(lv_obj_t * obj)
 {
     lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
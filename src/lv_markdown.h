@@ -16,7 +16,62 @@ extern "C" {
 #endif
 
 #include "lvgl.h"
+
+#if LVGL_VERSION_MAJOR != 9
+#error "lv_markdown needs LVGL 9"
+#endif
+
 #include "lv_markdown_style.h"
+#include "lv_markdown_alloc.h"
+#include "lv_markdown_msg.h"
+#include "lv_markdown_registry.h"
+#include "lv_markdown_batch.h"
+#include "lv_markdown_prerender.h"
+#include "lv_markdown_pack.h"
+#include "lv_markdown_trace.h"
+#include "lv_markdown_sched.h"
+#include "lv_markdown_huge.h"
+#include "lv_markdown_utf8.h"
+
+/** Appended to a preview that was cut short (the built-in fonts have no U+2026) */
+#ifndef LV_MARKDOWN_PREVIEW_ELLIPSIS
+#define LV_MARKDOWN_PREVIEW_ELLIPSIS "..."
+#endif
+
+/** Source bytes parsed for a preview, per allowed character and per allowed block */
+#ifndef LV_MARKDOWN_PREVIEW_BYTES_PER_CHAR
+#define LV_MARKDOWN_PREVIEW_BYTES_PER_CHAR 8
+#endif
+#ifndef LV_MARKDOWN_PREVIEW_BYTES_PER_BLOCK
+#define LV_MARKDOWN_PREVIEW_BYTES_PER_BLOCK 4096
+#endif
+
+/**
+ * Draw-cost profiles.
+ *
+ * LOW_COST swaps the styling that is slow on software renderers for cheaper
+ * equivalents: square code block corners, fully opaque blockquote borders,
+ * and a color change (faux_bold_color / faux_italic_color) instead of
+ * letter-spaced faux bold or underline faux italic. Real fonts are kept.
+ */
+typedef enum {
+    LV_MARKDOWN_DRAW_PROFILE_DEFAULT = 0,   /**< Full styling as configured */
+    LV_MARKDOWN_DRAW_PROFILE_LOW_COST,      /**< Cheapest-to-draw equivalents */
+} lv_markdown_draw_profile_t;
+
+/**
+ * Update statistics of a widget. `updates` counts text and style changes
+ * and `builds` the trees built from them. `coalesced` updates were replaced
+ * while waiting (see lv_markdown_set_coalesce), so their build was saved.
+ * `discarded` trees were replaced before any frame was drawn: work that was
+ * never seen, which coalescing would have saved.
+ */
+typedef struct {
+    uint32_t updates;       /**< set_text / set_text_static calls and restyles */
+    uint32_t builds;        /**< Trees built */
+    uint32_t coalesced;     /**< Updates replaced before they were built */
+    uint32_t discarded;     /**< Trees replaced before a frame was drawn */
+} lv_markdown_update_stats_t;
 
 /**
  * Create a markdown viewer widget.
@@ -56,6 +111,290 @@ void lv_markdown_set_text_static(lv_obj_t * obj, const char * text);
  */
 void lv_markdown_set_style(lv_obj_t * obj, const lv_markdown_style_t * style);
 
+/**
+ * Select the draw-cost profile. Re-renders if text is set.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param profile   LV_MARKDOWN_DRAW_PROFILE_DEFAULT or _LOW_COST
+ */
+void lv_markdown_set_draw_profile(lv_obj_t * obj, lv_markdown_draw_profile_t profile);
+
+/**
+ * Get the active draw-cost profile.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          the active profile
+ */
+lv_markdown_draw_profile_t lv_markdown_get_draw_profile(lv_obj_t * obj);
+
+/**
+ * Configure zoom levels: one complete style per zoom step, typically the
+ * same style with larger or smaller fonts. The array is NOT copied and must
+ * stay valid. Level 0 is applied with one full render; switching levels
+ * afterwards swaps fonts in place without re-parsing or rebuilding.
+ * Levels should differ only in fonts and line_spacing.
+ * lv_markdown_set_style turns zoom levels off.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param levels    array of styles, one per zoom level (NULL to turn off)
+ * @param count     number of levels
+ */
+void lv_markdown_set_zoom_levels(lv_obj_t * obj, const lv_markdown_style_t * levels, uint32_t count);
+
+/**
+ * Switch to a zoom level, e.g. when a pinch gesture settles.
+ * Visible blocks are re-wrapped now; offscreen blocks keep a cached (or
+ * estimated) height and are re-wrapped when scrolled into view.
+ * Also ends any transform started with lv_markdown_set_zoom_scale.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param level     index into the zoom levels
+ */
+void lv_markdown_set_zoom(lv_obj_t * obj, uint32_t level);
+
+/**
+ * Get the active zoom level.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          zoom level index (0 if zoom levels are not set)
+ */
+uint32_t lv_markdown_get_zoom(lv_obj_t * obj);
+
+/**
+ * Scale the rendered content with a transform, without any relayout.
+ * Meant for the duration of a pinch gesture; call lv_markdown_set_zoom
+ * when it settles.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param scale     LV_SCALE_NONE (256) = 100%
+ */
+void lv_markdown_set_zoom_scale(lv_obj_t * obj, int32_t scale);
+
+#if LV_USE_BIDI
+/**
+ * Enable or disable the bidi run cache (enabled by default).
+ * With the cache, each non-ASCII text run is converted to visual order once
+ * per text and reused by every relayout and redraw; it is emptied when the
+ * text changes. Re-renders if text is set.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param en        true to cache, false to let LVGL process runs on every draw
+ */
+void lv_markdown_set_bidi_cache(lv_obj_t * obj, bool en);
+#endif
+
+/**
+ * Switch to log mode for append-only content such as live log consoles.
+ * Clears the widget. lv_markdown_append then adds chunks at the tail, and
+ * once a limit is exceeded the oldest blocks are deleted from the head and
+ * their source bytes reclaimed. If a scrollable ancestor is scrolled into
+ * the log, its scroll position is moved with the deleted height so the
+ * visible lines stay in place.
+ * lv_markdown_set_text / _set_text_static leave log mode.
+ *
+ * @param obj           pointer to a markdown widget
+ * @param max_blocks    maximum number of blocks shown, 0 = unlimited
+ * @param max_bytes     maximum markdown source bytes kept, 0 = unlimited;
+ *                      a ring of this size is allocated once
+ *                      (both 0: leave log mode)
+ */
+void lv_markdown_set_log_mode(lv_obj_t * obj, uint32_t max_blocks, uint32_t max_bytes);
+
+/**
+ * Append markdown in log mode. The text is copied into the ring and parsed
+ * on its own (it can't continue a block from an earlier append); only its
+ * own blocks are created.
+ *
+ * @param obj       pointer to a markdown widget in log mode
+ * @param text      markdown to append, e.g. one or more log lines
+ * @return          LV_RESULT_OK, or LV_RESULT_INVALID if not in log mode,
+ *                  out of memory, or text is longer than max_bytes
+ */
+lv_result_t lv_markdown_append(lv_obj_t * obj, const char * text);
+
+/**
+ * Keep the nearest scrollable ancestor scrolled to the bottom as content
+ * is added, e.g. for streamed or appended text. The view is moved by the
+ * widget's height change after LVGL's regular layout, so an update never
+ * forces a layout of the whole document.
+ * Scrolling away from the bottom detaches; scrolling back re-attaches.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param en        true: follow the tail (and scroll to the bottom now)
+ */
+void lv_markdown_set_follow_tail(lv_obj_t * obj, bool en);
+
+/**
+ * Check if the view is currently following the tail.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          true if follow tail is on and the view is attached to the bottom
+ */
+bool lv_markdown_get_follow_tail(lv_obj_t * obj);
+
+/**
+ * Saved view of a document, see lv_markdown_save_state.
+ * Plain data: it can be kept across screens or written to storage as long
+ * as heights is stored along with it.
+ */
+typedef struct {
+    uint32_t  doc_hash;       /**< lv_markdown_pack_hash of the markdown text */
+    uint32_t  doc_len;        /**< Length of the markdown text */
+    int32_t   width;          /**< Widget width the heights were measured at */
+    uint32_t  anchor_block;   /**< Top-level block at the top of the view */
+    int32_t   anchor_offset;  /**< How far the view top is into that block */
+    uint32_t  block_cnt;      /**< Number of top-level blocks */
+    int32_t * heights;        /**< Height of each block (lv_malloc'd, see lv_markdown_state_free) */
+} lv_markdown_state_t;
+
+/**
+ * Capture the widget's view: the document identity, the block at the top
+ * of the nearest scrollable ancestor's view and every block's height at
+ * the current width. Not available in log mode.
+ *
+ * @param obj       pointer to a markdown widget with text set
+ * @param state     receives the state; free with lv_markdown_state_free
+ * @return          LV_RESULT_OK, or LV_RESULT_INVALID if there is no
+ *                  text, in log mode or out of memory
+ */
+lv_result_t lv_markdown_save_state(lv_obj_t * obj, lv_markdown_state_t * state);
+
+/**
+ * Put the view back where it was saved, e.g. right after recreating a
+ * screen and setting the same text. At the saved width, offscreen blocks
+ * take their saved heights and only the blocks in view are laid out now;
+ * the rest are laid out as they scroll into view. At another width the
+ * whole widget is laid out and the anchor block is still brought to the
+ * top.
+ *
+ * @param obj       pointer to a markdown widget with the saved text set
+ * @param state     state from lv_markdown_save_state
+ * @return          LV_RESULT_OK, or LV_RESULT_INVALID if the text or its
+ *                  blocks don't match the state (nothing is changed)
+ */
+lv_result_t lv_markdown_restore_state(lv_obj_t * obj, const lv_markdown_state_t * state);
+
+/**
+ * Free the heights of a saved state.
+ *
+ * @param state     state from lv_markdown_save_state
+ */
+void lv_markdown_state_free(lv_markdown_state_t * state);
+
+/**
+ * Show only the start of the document, e.g. in a list of previews. The
+ * parse stops once either limit is reached and LV_MARKDOWN_PREVIEW_ELLIPSIS
+ * is appended to the last text. Only the start of the source is handed to
+ * md4c (see LV_MARKDOWN_PREVIEW_BYTES_PER_CHAR), so the cost doesn't grow
+ * with the document. Link reference definitions further down don't apply.
+ * Not used in log and huge-document modes. Re-renders if text is set.
+ *
+ * @param obj           pointer to a markdown widget
+ * @param max_blocks    top-level blocks to show, 0 = no limit
+ * @param max_chars     characters of text to show, 0 = no limit
+ */
+void lv_markdown_set_preview_limits(lv_obj_t * obj, uint32_t max_blocks, uint32_t max_chars);
+
+/**
+ * Check whether the preview limits cut the current text short.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          true if the ellipsis was appended
+ */
+bool lv_markdown_get_preview_truncated(lv_obj_t * obj);
+
+/**
+ * Build the widget only when it is first shown. lv_markdown_set_text,
+ * _set_text_static and restyles then just keep the text; the tree is
+ * built at the start of the first frame the widget is in view, before
+ * that frame is drawn. Suits widgets on tabs, menus and screens that may
+ * never be opened. Turning it off builds a waiting widget now.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param en        true to build when shown
+ */
+void lv_markdown_set_lazy(lv_obj_t * obj, bool en);
+
+/**
+ * Check whether the widget builds when shown.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          true if lazy
+ */
+bool lv_markdown_get_lazy(lv_obj_t * obj);
+
+/**
+ * Build the widget at most once per frame. lv_markdown_set_text,
+ * _set_text_static and restyles then just keep the latest text; the tree
+ * is built once at the start of the next frame, before it is drawn. Suits
+ * data sources that update faster than the display refreshes. Turning it
+ * off builds a waiting widget now.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param en        true to build once per frame
+ */
+void lv_markdown_set_coalesce(lv_obj_t * obj, bool en);
+
+/**
+ * Check whether the widget builds once per frame.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          true if coalescing
+ */
+bool lv_markdown_get_coalesce(lv_obj_t * obj);
+
+/**
+ * Get the widget's update statistics, e.g. to decide on coalescing.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param stats     receives the statistics
+ */
+void lv_markdown_get_update_stats(lv_obj_t * obj, lv_markdown_update_stats_t * stats);
+
+/**
+ * Reset the widget's update statistics.
+ *
+ * @param obj       pointer to a markdown widget
+ */
+void lv_markdown_reset_update_stats(lv_obj_t * obj);
+
+/**
+ * Build the widget now if it waits to be shown or for the scheduler,
+ * e.g. before measuring it.
+ *
+ * @param obj       pointer to a markdown widget
+ */
+void lv_markdown_build(lv_obj_t * obj);
+
+/**
+ * Check whether the widget's tree matches its text and style.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          false while it waits to be shown or for the scheduler
+ */
+bool lv_markdown_is_built(lv_obj_t * obj);
+
+/**
+ * Choose what the next lv_markdown_set_text / _set_text_static does with
+ * invalid UTF-8. With LV_MARKDOWN_UTF8_REPAIR (default) invalid sequences
+ * are replaced with U+FFFD; a static text is then copied, so
+ * lv_markdown_get_text returns the repaired copy.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param policy    LV_MARKDOWN_UTF8_REPAIR, _CHECK or _OFF
+ */
+void lv_markdown_set_utf8_policy(lv_obj_t * obj, lv_markdown_utf8_policy_t policy);
+
+/**
+ * Check whether the current text was valid UTF-8 when it was set (before
+ * any repair). Always true with LV_MARKDOWN_UTF8_OFF and in log and
+ * huge-document modes.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          false if invalid sequences were found
+ */
+bool lv_markdown_get_utf8_valid(lv_obj_t * obj);
+
 /**
  * Get the currently set markdown text.
  *
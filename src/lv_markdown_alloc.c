@@ -0,0 +1,169 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown_alloc.h"
+#include "lv_markdown_md4c_alloc.h"
+
+/* md4c's allocations go to the LVGL heap, counted as PARSE.
+ * (The macros above only matter inside md4c.c.) */
+#undef malloc
+#undef realloc
+#undef free
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+void * lv_markdown_md4c_malloc(size_t size)
+{
+    lv_markdown_phase_t prev = lv_markdown_alloc_set_phase(LV_MARKDOWN_PHASE_PARSE);
+    void * p = lv_malloc(size);
+    lv_markdown_alloc_set_phase(prev);
+    return p;
+}
+
+void * lv_markdown_md4c_realloc(void * p, size_t size)
+{
+    lv_markdown_phase_t prev = lv_markdown_alloc_set_phase(LV_MARKDOWN_PHASE_PARSE);
+    void * np = lv_realloc(p, size);
+    lv_markdown_alloc_set_phase(prev);
+    return np;
+}
+
+void lv_markdown_md4c_free(void * p)
+{
+    lv_markdown_phase_t prev = lv_markdown_alloc_set_phase(LV_MARKDOWN_PHASE_PARSE);
+    lv_free(p);
+    lv_markdown_alloc_set_phase(prev);
+}
+
+#if LV_MARKDOWN_USE_ALLOC_STATS
+
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_CUSTOM
+#error "LV_MARKDOWN_USE_ALLOC_STATS requires LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM"
+#endif
+
+/* Each block is prefixed with its size; the header keeps max alignment */
+typedef union {
+    size_t      size;
+    long double align_ld;
+    void *      align_p;
+} alloc_header_t;
+
+static lv_markdown_alloc_stats_t stats[LV_MARKDOWN_PHASE_CNT];
+static intptr_t                  net_bytes[LV_MARKDOWN_PHASE_CNT];  /**< Allocated minus freed, per phase */
+static lv_markdown_phase_t       cur_phase;
+static size_t                    live_bytes;
+
+lv_markdown_phase_t lv_markdown_alloc_set_phase(lv_markdown_phase_t phase)
+{
+    lv_markdown_phase_t prev = cur_phase;
+    cur_phase = phase;
+    return prev;
+}
+
+void lv_markdown_alloc_stats_reset(void)
+{
+    memset(stats, 0, sizeof(stats));
+    memset(net_bytes, 0, sizeof(net_bytes));
+}
+
+void lv_markdown_alloc_stats_get(lv_markdown_phase_t phase, lv_markdown_alloc_stats_t * out)
+{
+    if(out == NULL || phase >= LV_MARKDOWN_PHASE_CNT) return;
+    *out = stats[phase];
+}
+
+size_t lv_markdown_alloc_live_bytes(void)
+{
+    return live_bytes;
+}
+
+static void note_growth(intptr_t delta)
+{
+    net_bytes[cur_phase] += delta;
+    if(net_bytes[cur_phase] > 0 && (size_t)net_bytes[cur_phase] > stats[cur_phase].peak) {
+        stats[cur_phase].peak = (size_t)net_bytes[cur_phase];
+    }
+}
+
+/* --- LVGL allocator core (LV_STDLIB_CUSTOM) --- */
+
+void lv_mem_init(void)
+{
+}
+
+void lv_mem_deinit(void)
+{
+}
+
+lv_mem_pool_t lv_mem_add_pool(void * mem, size_t bytes)
+{
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool)
+{
+    LV_UNUSED(pool);
+}
+
+void * lv_malloc_core(size_t size)
+{
+    alloc_header_t * h = malloc(sizeof(alloc_header_t) + size);
+    if(h == NULL) return NULL;
+    h->size = size;
+
+    stats[cur_phase].allocs++;
+    stats[cur_phase].bytes += size;
+    live_bytes += size;
+    note_growth((intptr_t)size);
+
+    return h + 1;
+}
+
+void * lv_realloc_core(void * p, size_t new_size)
+{
+    if(p == NULL) return lv_malloc_core(new_size);
+
+    alloc_header_t * h = (alloc_header_t *)p - 1;
+    size_t old_size = h->size;
+
+    alloc_header_t * nh = realloc(h, sizeof(alloc_header_t) + new_size);
+    if(nh == NULL) return NULL;
+    nh->size = new_size;
+
+    stats[cur_phase].reallocs++;
+    stats[cur_phase].bytes += new_size;
+    live_bytes = live_bytes - old_size + new_size;
+    note_growth((intptr_t)new_size - (intptr_t)old_size);
+
+    return nh + 1;
+}
+
+void lv_free_core(void * p)
+{
+    if(p == NULL) return;
+
+    alloc_header_t * h = (alloc_header_t *)p - 1;
+    stats[cur_phase].frees++;
+    live_bytes -= h->size;
+    note_growth(-(intptr_t)h->size);
+    free(h);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
+{
+    /* Only usage is known; there is no fixed pool */
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    mon_p->total_size = live_bytes;
+    mon_p->max_used   = live_bytes;
+    mon_p->used_pct   = 100;
+}
+
+lv_result_t lv_mem_test_core(void)
+{
+    return LV_RESULT_OK;
+}
+
+#endif /* LV_MARKDOWN_USE_ALLOC_STATS */
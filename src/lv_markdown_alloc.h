@@ -0,0 +1,93 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_alloc.h
+ * @brief Allocation statistics per render phase
+ *
+ * With LV_MARKDOWN_USE_ALLOC_STATS enabled, lv_markdown provides LVGL's
+ * allocator core (LV_USE_STDLIB_MALLOC must be LV_STDLIB_CUSTOM) on top of
+ * the C library and counts every lv_malloc/lv_realloc/lv_free, attributed to
+ * the render phase in progress:
+ *   - CLEAR: deleting the previous widget tree
+ *   - PARSE: md4c's own buffers (needs md4c built with MD4C_ALLOC_HEADER,
+ *            see lv_markdown_md4c_alloc.h)
+ *   - BUILD: objects, spans and styles created from the parse
+ * Allocations outside a render are counted under NONE.
+ *
+ * Intended for tests and profiling builds.
+ */
+
+#ifndef LV_MARKDOWN_ALLOC_H
+#define LV_MARKDOWN_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+#ifndef LV_MARKDOWN_USE_ALLOC_STATS
+#define LV_MARKDOWN_USE_ALLOC_STATS 0
+#endif
+
+typedef enum {
+    LV_MARKDOWN_PHASE_NONE = 0,
+    LV_MARKDOWN_PHASE_CLEAR,
+    LV_MARKDOWN_PHASE_PARSE,
+    LV_MARKDOWN_PHASE_BUILD,
+    LV_MARKDOWN_PHASE_CNT,
+} lv_markdown_phase_t;
+
+#if LV_MARKDOWN_USE_ALLOC_STATS
+
+typedef struct {
+    uint32_t allocs;        /**< lv_malloc calls (and lv_realloc of NULL) */
+    uint32_t reallocs;      /**< lv_realloc calls on existing blocks */
+    uint32_t frees;         /**< lv_free calls (and lv_realloc to 0) */
+    size_t   bytes;         /**< Bytes requested by allocs and reallocs */
+    size_t   peak;          /**< Highest net bytes (allocated - freed) held by the phase since reset */
+} lv_markdown_alloc_stats_t;
+
+/**
+ * Zero all phase statistics.
+ */
+void lv_markdown_alloc_stats_reset(void);
+
+/**
+ * Get the statistics of one phase since the last reset.
+ *
+ * @param phase     phase to query
+ * @param stats     receives the statistics
+ */
+void lv_markdown_alloc_stats_get(lv_markdown_phase_t phase, lv_markdown_alloc_stats_t * stats);
+
+/**
+ * Bytes currently allocated through lv_malloc (excluding headers).
+ *
+ * @return          live bytes
+ */
+size_t lv_markdown_alloc_live_bytes(void);
+
+/**
+ * Enter a phase. Used by the renderer; nestable.
+ *
+ * @param phase     phase to attribute allocations to
+ * @return          the previous phase, to pass to lv_markdown_alloc_set_phase afterwards
+ */
+lv_markdown_phase_t lv_markdown_alloc_set_phase(lv_markdown_phase_t phase);
+
+#else
+
+static inline lv_markdown_phase_t lv_markdown_alloc_set_phase(lv_markdown_phase_t phase)
+{
+    (void)phase;
+    return LV_MARKDOWN_PHASE_NONE;
+}
+
+#endif /* LV_MARKDOWN_USE_ALLOC_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_ALLOC_H */
@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_arena.c
+ * @brief Span text arena: one allocation for a document's span text
+ *
+ * Spans refer to their text with lv_span_set_text_static, so the strings
+ * of a document sit next to each other instead of in one heap block per
+ * span. Blocks are chained, never moved, so the pointers stay valid until
+ * the arena is freed.
+ */
+
+#include "lv_markdown_private.h"
+
+/* Smallest block added when the first one is full */
+#define ARENA_BLOCK_MIN 256
+
+struct lv_markdown_arena_block_t {
+    lv_markdown_arena_block_t * next;   /**< Previous (full) block */
+    uint32_t used;
+    uint32_t cap;
+    char     data[];
+};
+
+void lv_markdown_arena_reserve(lv_markdown_arena_t * arena, uint32_t size)
+{
+    if(arena->head == NULL) arena->next_size = size;
+}
+
+char * lv_markdown_arena_alloc(lv_markdown_arena_t * arena, uint32_t size)
+{
+    lv_markdown_arena_block_t * b = arena->head;
+    if(b == NULL || b->cap - b->used < size) {
+        uint32_t cap = LV_MAX(size, LV_MAX(arena->next_size, ARENA_BLOCK_MIN));
+        b = (lv_markdown_arena_block_t *)lv_malloc(sizeof(lv_markdown_arena_block_t) + cap);
+        if(b == NULL) return NULL;
+        b->next = arena->head;
+        b->used = 0;
+        b->cap  = cap;
+        arena->head      = b;
+        arena->next_size = ARENA_BLOCK_MIN;
+    }
+
+    char * p = b->data + b->used;
+    b->used += size;
+    return p;
+}
+
+void lv_markdown_arena_free(lv_markdown_arena_t * arena)
+{
+    lv_markdown_arena_block_t * b = arena->head;
+    while(b != NULL) {
+        lv_markdown_arena_block_t * next = b->next;
+        lv_free(b);
+        b = next;
+    }
+    arena->head      = NULL;
+    arena->next_size = 0;
+}
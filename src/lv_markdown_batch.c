@@ -0,0 +1,131 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown_batch.h"
+#include "lv_markdown.h"
+
+#if LV_USE_SNAPSHOT
+
+/* --- Internal data --- */
+
+struct lv_markdown_batch_t {
+    lv_display_t *    own_disp;    /**< Display created for headless use, NULL if borrowed */
+    lv_obj_t *        screen;      /**< Offscreen screen, never loaded */
+    lv_obj_t *        page;        /**< Fixed-size page that is snapshotted */
+    lv_obj_t *        md;          /**< Recycled markdown widget */
+    lv_draw_buf_t *   buf;         /**< Output buffer, reused for every document */
+    lv_color_format_t cf;          /**< Output color format */
+    uint32_t          docs;        /**< Documents rendered (stats) */
+    uint32_t          elapsed_ms;  /**< Time spent rendering them (stats) */
+};
+
+/* --- Public API --- */
+
+lv_markdown_batch_t * lv_markdown_batch_create(const lv_markdown_style_t * style, int32_t w, int32_t h,
+                                               lv_color_format_t cf)
+{
+    lv_markdown_batch_t * batch = (lv_markdown_batch_t *)lv_calloc(1, sizeof(lv_markdown_batch_t));
+    if(batch == NULL) return NULL;
+    batch->cf = cf;
+
+    /* Objects need a display; a headless one is never refreshed or flushed */
+    if(lv_display_get_default() == NULL) {
+        batch->own_disp = lv_display_create(w, h);
+        if(batch->own_disp == NULL) {
+            lv_free(batch);
+            return NULL;
+        }
+        lv_display_delete_refr_timer(batch->own_disp);
+    }
+
+    batch->buf = lv_draw_buf_create(w, h, cf, LV_STRIDE_AUTO);
+    if(batch->buf == NULL) {
+        lv_markdown_batch_delete(batch);
+        return NULL;
+    }
+
+    batch->screen = lv_obj_create(NULL);
+    batch->page = lv_obj_create(batch->screen);
+    lv_obj_remove_style_all(batch->page);
+    lv_obj_set_size(batch->page, w, h);
+    lv_obj_set_style_bg_color(batch->page, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(batch->page, LV_OPA_COVER, 0);
+    lv_obj_remove_flag(batch->page, LV_OBJ_FLAG_SCROLLABLE);
+
+    batch->md = lv_markdown_create(batch->page);
+    if(batch->md == NULL) {
+        lv_markdown_batch_delete(batch);
+        return NULL;
+    }
+    if(style != NULL) lv_markdown_set_style(batch->md, style);
+
+    return batch;
+}
+
+void lv_markdown_batch_delete(lv_markdown_batch_t * batch)
+{
+    if(batch == NULL) return;
+
+    if(batch->screen != NULL) lv_obj_delete(batch->screen);
+    if(batch->buf != NULL) lv_draw_buf_destroy(batch->buf);
+    if(batch->own_disp != NULL) lv_display_delete(batch->own_disp);
+    lv_free(batch);
+}
+
+const lv_draw_buf_t * lv_markdown_batch_render(lv_markdown_batch_t * batch, const char * text)
+{
+    if(batch == NULL) return NULL;
+
+    uint32_t t0 = lv_tick_get();
+
+    /* Same widget, style and parser config: only the blocks are rebuilt */
+    lv_markdown_set_text_static(batch->md, text);
+    /* The scheduler, lazy or coalescing building would otherwise leave the page empty */
+    lv_markdown_build(batch->md);
+    lv_obj_update_layout(batch->page);
+
+    lv_result_t res = lv_snapshot_take_to_draw_buf(batch->page, batch->cf, batch->buf);
+
+    batch->elapsed_ms += lv_tick_elaps(t0);
+    if(res != LV_RESULT_OK) return NULL;
+
+    batch->docs++;
+    return batch->buf;
+}
+
+uint32_t lv_markdown_batch_render_list(lv_markdown_batch_t * batch, const char * const * docs, uint32_t cnt,
+                                       lv_markdown_batch_cb_t cb, void * user_data)
+{
+    if(batch == NULL || docs == NULL) return 0;
+
+    uint32_t ok = 0;
+    for(uint32_t i = 0; i < cnt; i++) {
+        const lv_draw_buf_t * buf = lv_markdown_batch_render(batch, docs[i]);
+        if(buf == NULL) continue;
+        ok++;
+        if(cb != NULL) cb(i, buf, user_data);
+    }
+
+    /* Don't keep pointers into the caller's list */
+    lv_markdown_set_text_static(batch->md, NULL);
+
+    return ok;
+}
+
+void lv_markdown_batch_get_stats(const lv_markdown_batch_t * batch, lv_markdown_batch_stats_t * stats)
+{
+    if(batch == NULL || stats == NULL) return;
+
+    stats->docs         = batch->docs;
+    stats->elapsed_ms   = batch->elapsed_ms;
+    stats->docs_per_sec = batch->elapsed_ms ? (uint32_t)((uint64_t)batch->docs * 1000 / batch->elapsed_ms) : 0;
+}
+
+void lv_markdown_batch_reset_stats(lv_markdown_batch_t * batch)
+{
+    if(batch == NULL) return;
+
+    batch->docs       = 0;
+    batch->elapsed_ms = 0;
+}
+
+#endif /* LV_USE_SNAPSHOT */
@@ -0,0 +1,109 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_batch.h
+ * @brief Offscreen batch rendering of markdown documents (thumbnails)
+ *
+ * A batch renderer owns one offscreen page with one markdown widget, one
+ * style and one draw buffer. Each document is rendered into that recycled
+ * tree and snapshotted into the buffer; nothing is flushed to a display.
+ *
+ * Requires LV_USE_SNAPSHOT.
+ */
+
+#ifndef LV_MARKDOWN_BATCH_H
+#define LV_MARKDOWN_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+#include "lv_markdown_style.h"
+
+#if LV_USE_SNAPSHOT
+
+typedef struct lv_markdown_batch_t lv_markdown_batch_t;
+
+/**
+ * Called once per rendered document.
+ *
+ * @param index     index of the document in the list
+ * @param buf       the rendered page; reused for the next document, copy it if needed
+ * @param user_data user data passed to lv_markdown_batch_render_list
+ */
+typedef void (*lv_markdown_batch_cb_t)(uint32_t index, const lv_draw_buf_t * buf, void * user_data);
+
+typedef struct {
+    uint32_t docs;          /**< Documents rendered since create / reset */
+    uint32_t elapsed_ms;    /**< Time spent rendering them (lv_tick based) */
+    uint32_t docs_per_sec;  /**< docs / elapsed, 0 if too fast to measure */
+} lv_markdown_batch_stats_t;
+
+/**
+ * Create a batch renderer.
+ * If no display exists yet (e.g. on a build server), one is created
+ * without buffers and deleted with the batch.
+ *
+ * @param style     style for all documents (copied), NULL for defaults
+ * @param w         page width in pixels
+ * @param h         page height in pixels; longer documents are cut off
+ * @param cf        color format of the output buffer, e.g. LV_COLOR_FORMAT_RGB565
+ * @return          the batch renderer, or NULL if out of memory
+ */
+lv_markdown_batch_t * lv_markdown_batch_create(const lv_markdown_style_t * style, int32_t w, int32_t h,
+                                               lv_color_format_t cf);
+
+/**
+ * Delete a batch renderer and its page, buffer and (if created) display.
+ *
+ * @param batch     pointer to a batch renderer
+ */
+void lv_markdown_batch_delete(lv_markdown_batch_t * batch);
+
+/**
+ * Render one document.
+ *
+ * @param batch     pointer to a batch renderer
+ * @param text      markdown source, must stay valid until the next render
+ * @return          the rendered page (owned by the batch, overwritten by the
+ *                  next render), or NULL on failure
+ */
+const lv_draw_buf_t * lv_markdown_batch_render(lv_markdown_batch_t * batch, const char * text);
+
+/**
+ * Render a list of documents, calling `cb` after each one.
+ *
+ * @param batch     pointer to a batch renderer
+ * @param docs      markdown sources
+ * @param cnt       number of entries in docs
+ * @param cb        called with each rendered page (may be NULL)
+ * @param user_data passed to cb
+ * @return          number of documents rendered successfully
+ */
+uint32_t lv_markdown_batch_render_list(lv_markdown_batch_t * batch, const char * const * docs, uint32_t cnt,
+                                       lv_markdown_batch_cb_t cb, void * user_data);
+
+/**
+ * Get throughput statistics. Timing needs an LVGL tick source
+ * (lv_tick_set_cb or lv_tick_inc).
+ *
+ * @param batch     pointer to a batch renderer
+ * @param stats     receives the statistics
+ */
+void lv_markdown_batch_get_stats(const lv_markdown_batch_t * batch, lv_markdown_batch_stats_t * stats);
+
+/**
+ * Reset the throughput statistics.
+ *
+ * @param batch     pointer to a batch renderer
+ */
+void lv_markdown_batch_reset_stats(lv_markdown_batch_t * batch);
+
+#endif /* LV_USE_SNAPSHOT */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_BATCH_H */
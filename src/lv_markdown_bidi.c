@@ -0,0 +1,139 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown_private.h"
+
+#if LV_USE_BIDI
+
+#include <string.h>
+
+static uint32_t bidi_hash(const char * text, uint32_t len)
+{
+    uint32_t h = 2166136261u;
+    for(uint32_t i = 0; i < len; i++) {
+        h ^= (uint8_t)text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+ * Grow the table to new_cnt slots and re-insert the existing entries.
+ */
+static int bidi_cache_grow(lv_markdown_bidi_cache_t * cache, uint32_t new_cnt)
+{
+    lv_markdown_bidi_entry_t * slots = lv_calloc(new_cnt, sizeof(lv_markdown_bidi_entry_t));
+    if(slots == NULL) return 0;
+
+    for(uint32_t i = 0; i < cache->slot_cnt; i++) {
+        lv_markdown_bidi_entry_t * e = &cache->slots[i];
+        if(e->visual == NULL) continue;
+        uint32_t j = e->hash & (new_cnt - 1);
+        while(slots[j].visual != NULL) j = (j + 1) & (new_cnt - 1);
+        slots[j] = *e;
+    }
+
+    lv_free(cache->slots);
+    cache->slots    = slots;
+    cache->slot_cnt = new_cnt;
+    return 1;
+}
+
+const char * lv_markdown_bidi_cache_get(lv_markdown_bidi_cache_t * cache, const char * text, uint32_t len,
+                                        lv_base_dir_t dir)
+{
+    /* Entries handed out in this frame may be referenced by queued draw
+     * tasks, so a flush waits for the next frame */
+    uint32_t frame = lv_markdown_lazy_get_frame();
+    if(cache->flush && frame != cache->frame) lv_markdown_bidi_cache_clear(cache);
+    cache->frame = frame;
+
+    uint32_t hash = bidi_hash(text, len);
+
+    if(cache->slot_cnt != 0) {
+        uint32_t i = hash & (cache->slot_cnt - 1);
+        while(cache->slots[i].visual != NULL) {
+            lv_markdown_bidi_entry_t * e = &cache->slots[i];
+            if(e->hash == hash && e->len == len && e->dir == (uint8_t)dir &&
+               memcmp(e->visual + len + 1, text, len) == 0) {
+                cache->hits++;
+                return e->visual;
+            }
+            i = (i + 1) & (cache->slot_cnt - 1);
+        }
+    }
+
+    /* Miss. A full cache is emptied at the next frame; until then the
+     * caller falls back to LVGL's own pass */
+    if(cache->used >= LV_MARKDOWN_BIDI_CACHE_MAX) {
+        cache->flush = 1;
+        return NULL;
+    }
+
+    /* Keep the load factor at or below 1/2 */
+    if((cache->used + 1) * 2 > cache->slot_cnt) {
+        if(!bidi_cache_grow(cache, cache->slot_cnt == 0 ? 32 : cache->slot_cnt * 2)) return NULL;
+    }
+
+    /* Visual text, then the logical text it came from (for exact matching) */
+    char * visual = lv_malloc(2 * (size_t)len + 1);
+    if(visual == NULL) return NULL;
+    lv_bidi_process_paragraph(text, visual, len, dir, NULL, 0);
+    visual[len] = '\0';
+    memcpy(visual + len + 1, text, len);
+    cache->misses++;
+
+    uint32_t i = hash & (cache->slot_cnt - 1);
+    while(cache->slots[i].visual != NULL) i = (i + 1) & (cache->slot_cnt - 1);
+    cache->slots[i].hash   = hash;
+    cache->slots[i].len    = len;
+    cache->slots[i].dir    = (uint8_t)dir;
+    cache->slots[i].visual = visual;
+    cache->used++;
+
+    return visual;
+}
+
+void lv_markdown_bidi_cache_clear(lv_markdown_bidi_cache_t * cache)
+{
+    for(uint32_t i = 0; i < cache->slot_cnt; i++) {
+        if(cache->slots[i].visual != NULL) lv_free(cache->slots[i].visual);
+    }
+    lv_free(cache->slots);
+    cache->slots    = NULL;
+    cache->slot_cnt = 0;
+    cache->used     = 0;
+    cache->flush    = 0;
+}
+
+void lv_markdown_bidi_cache_set_width(lv_markdown_bidi_cache_t * cache, int32_t width)
+{
+    if(cache->width != width && cache->used > 0) cache->flush = 1;
+    cache->width = width;
+}
+
+void lv_markdown_bidi_draw_task_cb(lv_event_t * e)
+{
+    lv_draw_task_t * task = lv_event_get_draw_task(e);
+    if(lv_draw_task_get_type(task) != LV_DRAW_TASK_TYPE_LABEL) return;
+
+    lv_draw_label_dsc_t * dsc = lv_draw_task_get_label_dsc(task);
+    if(dsc == NULL || dsc->text == NULL || dsc->has_bided) return;
+
+    /* Spangroups emit one task per line piece, so each task is a single line */
+    uint32_t len = dsc->text_length != LV_TEXT_LEN_MAX ? dsc->text_length : (uint32_t)strlen(dsc->text);
+    lv_markdown_bidi_cache_t * cache = lv_event_get_user_data(e);
+    const char * visual = lv_markdown_bidi_cache_get(cache, dsc->text, len, dsc->bidi_dir);
+    if(visual == NULL) return;
+
+    if(dsc->text_local) {
+        /* The task owns a copy: overwrite it (bidi keeps the byte length) */
+        memcpy((char *)dsc->text, visual, len);
+    }
+    else {
+        /* Borrowed text: point at the cached run, which outlives this frame */
+        dsc->text = visual;
+    }
+    dsc->has_bided = 1;
+}
+
+#endif /* LV_USE_BIDI */
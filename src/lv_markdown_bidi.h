@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_bidi.h
+ * @brief Cache of bidi-processed (visual order) text runs
+ *
+ * Not part of the public API. Compiled only when LV_USE_BIDI is enabled.
+ */
+
+#ifndef LV_MARKDOWN_BIDI_H
+#define LV_MARKDOWN_BIDI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+#if LV_USE_BIDI
+
+/** Maximum cached runs per widget. A full cache is emptied at the next frame;
+ *  until then further runs are processed by LVGL as usual */
+#ifndef LV_MARKDOWN_BIDI_CACHE_MAX
+#define LV_MARKDOWN_BIDI_CACHE_MAX 512
+#endif
+
+typedef struct {
+    uint32_t hash;      /**< FNV-1a of the logical text */
+    uint32_t len;       /**< Text length in bytes */
+    uint8_t  dir;       /**< lv_base_dir_t the run was processed with */
+    char *   visual;    /**< Visual text + NUL + logical text, NULL = empty slot */
+} lv_markdown_bidi_entry_t;
+
+typedef struct {
+    lv_markdown_bidi_entry_t * slots;   /**< Open-addressed table, power-of-two size */
+    uint32_t slot_cnt;                  /**< Table size (0 = not allocated) */
+    uint32_t used;                      /**< Filled slots */
+    uint32_t hits;                      /**< Lookups served from the cache */
+    uint32_t misses;                    /**< Lookups that ran lv_bidi_process_paragraph */
+    uint32_t frame;                     /**< Frame of the last lookup (see lv_markdown_lazy_get_frame) */
+    int32_t  width;                     /**< Widget width the runs were wrapped at */
+    uint8_t  flush;                     /**< 1 = empty the cache at the next frame */
+} lv_markdown_bidi_cache_t;
+
+/**
+ * Get the visual-order form of a text run, processing it on first use.
+ *
+ * @param cache     pointer to a zero-initialized cache
+ * @param text      logical-order text (need not be NUL-terminated)
+ * @param len       length of text in bytes
+ * @param dir       base direction to process with
+ * @return          visual-order text of the same length, valid until the
+ *                  end of the next frame at least; NULL if the cache is full
+ *                  or out of memory
+ */
+const char * lv_markdown_bidi_cache_get(lv_markdown_bidi_cache_t * cache, const char * text, uint32_t len,
+                                        lv_base_dir_t dir);
+
+/**
+ * Free all entries. Call whenever the source text changes.
+ * Hit/miss counters are kept.
+ *
+ * @param cache     pointer to a cache
+ */
+void lv_markdown_bidi_cache_clear(lv_markdown_bidi_cache_t * cache);
+
+/**
+ * Tell the cache the widget's width. When it changes, lines wrap anew and
+ * the cached runs are emptied at the next frame.
+ *
+ * @param cache     pointer to a cache
+ * @param width     width of the widget
+ */
+void lv_markdown_bidi_cache_set_width(lv_markdown_bidi_cache_t * cache, int32_t width);
+
+/**
+ * LV_EVENT_DRAW_TASK_ADDED handler that replaces label draw tasks' text
+ * with the cached visual-order run, so LVGL skips its own per-line bidi pass.
+ * The event user data must be the lv_markdown_bidi_cache_t.
+ *
+ * @param e         pointer to the event
+ */
+void lv_markdown_bidi_draw_task_cb(lv_event_t * e);
+
+#endif /* LV_USE_BIDI */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_BIDI_H */
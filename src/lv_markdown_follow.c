@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_follow.c
+ * @brief Follow tail: keep a scrolled view pinned to the newest content
+ *
+ * Instead of laying out the widget after every update to find the new
+ * content height, the view is moved from the widget's own SIZE_CHANGED
+ * event, which LVGL sends from its regular layout pass with the height
+ * delta of the changed blocks. Only the scrollable ancestor's extents are
+ * read, never the markdown blocks themselves.
+ */
+
+#include "lv_markdown.h"
+#include "lv_markdown_private.h"
+
+/* --- Event handlers --- */
+
+/**
+ * Move the view by the widget's height change if it is attached.
+ */
+static void follow_size_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->follow_scroller == NULL) return;
+
+    int32_t h = lv_obj_get_height(obj);
+    int32_t dh = h - data->follow_h;
+    data->follow_h = h;
+    if(dh == 0 || !data->follow_attached) return;
+
+    /* Grown: scroll down until the bottom is reached. Shrunk: scroll up, but
+     * not past the top. */
+    lv_obj_t * scroller = data->follow_scroller;
+    int32_t bottom = lv_obj_get_scroll_bottom(scroller);
+    int32_t dy = bottom > 0 ? bottom : -LV_MIN(-bottom, lv_obj_get_scroll_top(scroller));
+    if(dy == 0) return;
+
+    data->follow_busy = 1;
+    lv_obj_scroll_by(scroller, 0, -dy, LV_ANIM_OFF);
+    data->follow_busy = 0;
+}
+
+/**
+ * Detach when the view is scrolled away from the bottom, re-attach when
+ * it is scrolled back.
+ */
+static void follow_scroll_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = (lv_obj_t *)lv_event_get_user_data(e);
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->follow_busy) return;
+
+    data->follow_attached = lv_obj_get_scroll_bottom(data->follow_scroller) <= 0;
+}
+
+/* --- Internal API --- */
+
+void lv_markdown_follow_reset(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(data->follow_scroller == NULL) return;
+
+    lv_obj_remove_event_cb_with_user_data(data->follow_scroller, follow_scroll_cb, obj);
+    lv_obj_remove_event_cb(obj, follow_size_cb);
+    data->follow_scroller = NULL;
+    data->follow_attached = 0;
+}
+
+/* --- Public API --- */
+
+void lv_markdown_set_follow_tail(lv_obj_t * obj, bool en)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    lv_markdown_follow_reset(obj, data);
+    if(!en) return;
+
+    lv_obj_t * scroller = lv_obj_get_parent(obj);
+    while(scroller != NULL && !lv_obj_has_flag(scroller, LV_OBJ_FLAG_SCROLLABLE)) {
+        scroller = lv_obj_get_parent(scroller);
+    }
+    if(scroller == NULL) return;
+
+    lv_obj_add_event_cb(scroller, follow_scroll_cb, LV_EVENT_SCROLL, obj);
+    lv_obj_add_event_cb(obj, follow_size_cb, LV_EVENT_SIZE_CHANGED, NULL);
+    data->follow_scroller = scroller;
+    data->follow_h        = lv_obj_get_height(obj);
+
+    /* Start at the bottom */
+    int32_t bottom = lv_obj_get_scroll_bottom(scroller);
+    if(bottom > 0) {
+        data->follow_busy = 1;
+        lv_obj_scroll_by(scroller, 0, -bottom, LV_ANIM_OFF);
+        data->follow_busy = 0;
+    }
+    data->follow_attached = 1;
+}
+
+bool lv_markdown_get_follow_tail(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return false;
+
+    return data->follow_scroller != NULL && data->follow_attached;
+}
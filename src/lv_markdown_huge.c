@@ -0,0 +1,540 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_huge.c
+ * @brief Huge-document mode: sparse line index and a sliding window
+ *
+ * Marks are placed at the first line that can start a new document without
+ * changing how the blocks around it parse: a line at column 0 after a blank
+ * line, outside fenced code and the HTML blocks that run across blank lines
+ * (<script>, <pre>, <style>, <textarea>, comments, processing instructions,
+ * declarations and CDATA), and not a list item, which could continue a
+ * loose list. Link reference definitions still apply only to the section
+ * that holds them. If no such line comes within
+ * LV_MARKDOWN_HUGE_SECTION_MAX bytes, the section is cut at the last line
+ * after a blank line outside fenced code and HTML, which splits at most a
+ * loose list. Without one, it is cut at the next line with a warning; a cut
+ * inside fenced code remembers the fence, and the section is parsed with
+ * the fence opened again in front of it.
+ */
+
+#include "lv_markdown_huge.h"
+#include "lv_markdown_private.h"
+
+#include <string.h>
+
+/* --- Internal data --- */
+
+typedef struct {
+    uint64_t off;        /**< Byte offset of the section */
+    uint64_t line;       /**< 0-based line number of its first line */
+    uint16_t fence_len;  /**< >0: starts inside fenced code opened by this many fence_ch */
+    char     fence_ch;
+} huge_mark_t;
+
+struct lv_markdown_huge_t {
+    const char *  text;         /**< Caller's text (not owned) */
+    size_t        len;
+    uint64_t      line_cnt;
+    huge_mark_t * marks;        /**< Section starts, ascending */
+    uint32_t      mark_cnt;
+    uint32_t      mark_cap;
+    uint32_t      first;        /**< First section shown */
+    uint32_t      shown;        /**< Sections shown */
+    uint32_t      blocks[LV_MARKDOWN_HUGE_WINDOW]; /**< Blocks of each shown section */
+    lv_obj_t *    scroller;     /**< Scrollable ancestor that slides the window, NULL = none */
+    uint8_t       busy;         /**< 1 while sliding */
+};
+
+/* --- Line index --- */
+
+static int huge_push_mark(lv_markdown_huge_t * huge, uint64_t off, uint64_t line, char fence_ch, uint32_t fence_len)
+{
+    if(huge->mark_cnt == huge->mark_cap) {
+        uint32_t new_cap = huge->mark_cap ? huge->mark_cap * 2 : 64;
+        huge_mark_t * marks = (huge_mark_t *)lv_realloc(huge->marks, new_cap * sizeof(huge_mark_t));
+        if(marks == NULL) return 0;
+        huge->marks    = marks;
+        huge->mark_cap = new_cap;
+    }
+
+    huge_mark_t * m = &huge->marks[huge->mark_cnt++];
+    m->off       = off;
+    m->line      = line;
+    m->fence_ch  = fence_ch;
+    m->fence_len = (uint16_t)LV_MIN(fence_len, UINT16_MAX);
+    return 1;
+}
+
+static bool huge_match(const char * s, const char * le, const char * str)
+{
+    size_t n = strlen(str);
+    if((size_t)(le - s) < n) return false;
+    for(size_t i = 0; i < n; i++) {
+        char c = s[i];
+        if(c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        if(c != str[i]) return false;
+    }
+    return true;
+}
+
+static bool huge_contains(const char * s, const char * le, const char * str)
+{
+    for(; s < le; s++) {
+        if(huge_match(s, le, str)) return true;
+    }
+    return false;
+}
+
+/**
+ * HTML block that a line starts and that only its end marker closes
+ * (CommonMark types 1-5).
+ *
+ * @return the type, 0 = none
+ */
+static uint8_t huge_html_start(const char * s, const char * le)
+{
+    static const char * const tags[] = {"<script", "<pre", "<style", "<textarea"};
+
+    if(s == le || *s != '<') return 0;
+    for(uint32_t i = 0; i < sizeof(tags) / sizeof(tags[0]); i++) {
+        if(!huge_match(s, le, tags[i])) continue;
+        const char * r = s + strlen(tags[i]);
+        if(r == le || *r == ' ' || *r == '\t' || *r == '\r' || *r == '>') return 1;
+    }
+    if(huge_match(s, le, "<!--")) return 2;
+    if(huge_match(s, le, "<?")) return 3;
+    if(huge_match(s, le, "<![cdata[")) return 5;
+    if(le - s > 2 && s[1] == '!' && ((s[2] >= 'A' && s[2] <= 'Z') || (s[2] >= 'a' && s[2] <= 'z'))) return 4;
+    return 0;
+}
+
+static bool huge_html_end(uint8_t type, const char * s, const char * le)
+{
+    switch(type) {
+        case 1:
+            return huge_contains(s, le, "</script>") || huge_contains(s, le, "</pre>") ||
+                   huge_contains(s, le, "</style>") || huge_contains(s, le, "</textarea>");
+        case 2:
+            return huge_contains(s, le, "-->");
+        case 3:
+            return huge_contains(s, le, "?>");
+        case 4:
+            return huge_contains(s, le, ">");
+        default:
+            return huge_contains(s, le, "]]>");
+    }
+}
+
+/**
+ * A bullet or ordered list marker at s.
+ */
+static bool huge_list_item(const char * s, const char * le)
+{
+    const char * r = s;
+    if(r < le && (*r == '-' || *r == '+' || *r == '*')) {
+        r++;
+    }
+    else {
+        while(r < le && r - s < 9 && *r >= '0' && *r <= '9') r++;
+        if(r == s || r == le || (*r != '.' && *r != ')')) return false;
+        r++;
+    }
+    return r == le || *r == ' ' || *r == '\t' || *r == '\r';
+}
+
+/**
+ * One pass over the text: count lines and place marks.
+ */
+static lv_result_t huge_index(lv_markdown_huge_t * huge, uint32_t mark_lines)
+{
+    const char * text = huge->text;
+    const char * end = text + huge->len;
+    const char * p = text;
+    uint64_t line = 0;
+    uint64_t since = 0;         /* lines since the last mark */
+    uint64_t mark_off = 0;
+    uint64_t soft_off = 0;      /* last line after a blank line since the mark, 0 = none */
+    uint64_t soft_line = 0;
+    char fence_ch = 0;
+    uint32_t fence_len = 0;     /* 0 = not in fenced code */
+    uint8_t html = 0;           /* type of the open HTML block, 0 = none */
+    bool prev_blank = false;
+
+    if(!huge_push_mark(huge, 0, 0, 0, 0)) return LV_RESULT_INVALID;
+
+    while(p < end) {
+        const char * eol = (const char *)memchr(p, '\n', (size_t)(end - p));
+        const char * le = eol != NULL ? eol : end;
+        uint64_t off = (uint64_t)(p - text);
+
+        const char * s = p;
+        uint32_t indent = 0;
+        while(s < le && *s == ' ' && indent < 4) {
+            s++;
+            indent++;
+        }
+        const char * q = s;
+        while(q < le && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+        bool blank = q == le;
+
+        if(off > mark_off) {
+            bool soft = fence_len == 0 && html == 0 && prev_blank && !blank && indent < 4 && *p != '\t';
+            bool boundary = soft && since >= mark_lines && indent == 0 && !huge_list_item(p, le);
+            if(soft) {
+                soft_off  = off;
+                soft_line = line;
+            }
+            if(boundary) {
+                if(!huge_push_mark(huge, off, line, 0, 0)) return LV_RESULT_INVALID;
+                mark_off = off;
+                since    = 0;
+            }
+            else if(off - mark_off >= LV_MARKDOWN_HUGE_SECTION_MAX) {
+                if(soft_off > mark_off) {
+                    if(!huge_push_mark(huge, soft_off, soft_line, 0, 0)) return LV_RESULT_INVALID;
+                    mark_off = soft_off;
+                    since    = line - soft_line;
+                }
+                else {
+                    LV_LOG_WARN("no blank line in %lu bytes, section cut inside a block at line %lu",
+                                (unsigned long)(off - mark_off), (unsigned long)(line + 1));
+                    if(!huge_push_mark(huge, off, line, fence_ch, fence_len)) return LV_RESULT_INVALID;
+                    mark_off = off;
+                    since    = 0;
+                }
+            }
+        }
+
+        /* HTML blocks that blank lines don't end: closed by their end marker,
+         * which may be on the line that opens them */
+        if(html != 0) {
+            if(huge_html_end(html, p, le)) html = 0;
+        }
+        else if(fence_len == 0 && indent < 4) {
+            html = huge_html_start(s, le);
+            if(html != 0 && huge_html_end(html, s + 2, le)) html = 0;
+        }
+
+        /* Fenced code: ``` or ~~~, closed by at least as many of the same */
+        if(html == 0 && indent < 4 && s < le && (*s == '`' || *s == '~')) {
+            uint32_t n = 0;
+            while(s + n < le && s[n] == *s) n++;
+            if(n >= 3) {
+                if(fence_len == 0) {
+                    fence_ch  = *s;
+                    fence_len = n;
+                }
+                else if(*s == fence_ch && n >= fence_len) {
+                    const char * r = s + n;
+                    while(r < le && (*r == ' ' || *r == '\t' || *r == '\r')) r++;
+                    if(r == le) fence_len = 0;
+                }
+            }
+        }
+
+        prev_blank = blank;
+        line++;
+        since++;
+        p = eol != NULL ? eol + 1 : end;
+    }
+
+    huge->line_cnt = line;
+    return LV_RESULT_OK;
+}
+
+/* --- Window --- */
+
+/**
+ * Parse one section and add its blocks after the existing children.
+ *
+ * @return number of blocks added
+ */
+static uint32_t huge_render_section(lv_obj_t * obj, lv_markdown_data_t * data, uint32_t sec)
+{
+    lv_markdown_huge_t * huge = data->huge;
+    const huge_mark_t * m = &huge->marks[sec];
+    uint64_t end = sec + 1 < huge->mark_cnt ? huge->marks[sec + 1].off : (uint64_t)huge->len;
+    uint64_t len = end - m->off;
+
+    /* A single line beyond md4c's offset range can't be shown */
+    if(len >= UINT32_MAX / 2) {
+        LV_LOG_WARN("section at line %lu is too long to render (%lu bytes), skipped",
+                    (unsigned long)(m->line + 1), (unsigned long)len);
+        return 0;
+    }
+
+    const char * src = huge->text + m->off;
+    char * buf = NULL;
+    if(m->fence_len > 0) {
+        buf = (char *)lv_malloc((size_t)len + m->fence_len + 1);
+        if(buf == NULL) return 0;
+        lv_memset(buf, (uint8_t)m->fence_ch, m->fence_len);
+        buf[m->fence_len] = '\n';
+        lv_memcpy(buf + m->fence_len + 1, src, (size_t)len);
+        src = buf;
+        len += m->fence_len + 1;
+    }
+
+    uint32_t before = lv_obj_get_child_count(obj);
+    lv_markdown_render_into(obj, &data->style, data->draw_profile, src, (size_t)len);
+    lv_free(buf);
+    return lv_obj_get_child_count(obj) - before;
+}
+
+/**
+ * Update the block count and the first block's margin after the window moved.
+ * Zoom bookkeeping is kept by the callers, per added or dropped section.
+ */
+static void huge_window_changed(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    lv_markdown_huge_t * huge = data->huge;
+
+    uint32_t blocks = 0;
+    for(uint32_t i = 0; i < huge->shown; i++) blocks += huge->blocks[i];
+    if(blocks > 0) lv_obj_set_style_margin_top(lv_obj_get_child(obj, 0), 0, 0);
+
+    data->block_count = blocks;
+}
+
+/**
+ * Replace the window with the sections starting at `first`, moved back if
+ * needed to fill the window.
+ */
+static void huge_show(lv_obj_t * obj, lv_markdown_data_t * data, uint32_t first)
+{
+    lv_markdown_huge_t * huge = data->huge;
+
+    lv_markdown_phase_t prev = lv_markdown_alloc_set_phase(LV_MARKDOWN_PHASE_CLEAR);
+    lv_obj_clean(obj);
+    lv_markdown_alloc_set_phase(prev);
+
+    uint32_t last = LV_MIN(first + LV_MARKDOWN_HUGE_WINDOW, huge->mark_cnt);
+    first = last > LV_MARKDOWN_HUGE_WINDOW ? LV_MIN(first, last - LV_MARKDOWN_HUGE_WINDOW) : 0;
+
+    huge->first = first;
+    huge->shown = last - first;
+    for(uint32_t i = 0; i < huge->shown; i++) {
+        huge->blocks[i] = huge_render_section(obj, data, first + i);
+    }
+    huge_window_changed(obj, data);
+    lv_markdown_zoom_tree_changed(obj, data);
+}
+
+/**
+ * Add the next section at the bottom. A full window drops its first section
+ * and the view is moved back by its height, as log mode does.
+ */
+static void huge_slide_down(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    lv_markdown_huge_t * huge = data->huge;
+
+    uint32_t before = lv_obj_get_child_count(obj);
+    uint32_t n = huge_render_section(obj, data, huge->first + huge->shown);
+    lv_markdown_zoom_blocks_added(obj, data, before, n);
+
+    if(huge->shown == LV_MARKDOWN_HUGE_WINDOW) {
+        uint32_t drop = huge->blocks[0];
+        uint32_t child_cnt = lv_obj_get_child_count(obj);
+
+        /* Height of the dropped blocks, from the last layout */
+        int32_t dy = 0;
+        if(drop > 0 && drop < child_cnt) {
+            dy = lv_obj_get_y(lv_obj_get_child(obj, (int32_t)drop)) - lv_obj_get_y(lv_obj_get_child(obj, 0));
+        }
+        lv_markdown_zoom_blocks_removed(obj, data, 0, drop);
+        for(uint32_t i = 0; i < drop; i++) {
+            lv_obj_delete(lv_obj_get_child(obj, 0));
+        }
+
+        memmove(&huge->blocks[0], &huge->blocks[1], (huge->shown - 1) * sizeof(uint32_t));
+        huge->first++;
+        huge->shown--;
+
+        int32_t top = lv_obj_get_scroll_top(huge->scroller);
+        if(dy > 0 && top > 0) lv_obj_scroll_by(huge->scroller, 0, LV_MIN(dy, top), LV_ANIM_OFF);
+    }
+
+    huge->blocks[huge->shown++] = n;
+    huge_window_changed(obj, data);
+}
+
+/**
+ * Add the previous section at the top and move the view down by its
+ * height. A full window drops its last section.
+ */
+static void huge_slide_up(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    lv_markdown_huge_t * huge = data->huge;
+
+    lv_obj_t * old_first = lv_obj_get_child(obj, 0);
+    uint32_t before = lv_obj_get_child_count(obj);
+    uint32_t n = huge_render_section(obj, data, huge->first - 1);
+    for(uint32_t k = 0; k < n; k++) {
+        lv_obj_move_to_index(lv_obj_get_child(obj, (int32_t)(before + k)), (int32_t)k);
+    }
+    lv_markdown_zoom_blocks_added(obj, data, 0, n);
+    if(n > 0 && old_first != NULL) {
+        lv_obj_set_style_margin_top(old_first, data->style.paragraph_spacing, 0);
+    }
+
+    if(huge->shown == LV_MARKDOWN_HUGE_WINDOW) {
+        uint32_t drop = huge->blocks[huge->shown - 1];
+        lv_markdown_zoom_blocks_removed(obj, data, lv_obj_get_child_count(obj) - drop, drop);
+        for(uint32_t k = 0; k < drop; k++) {
+            lv_obj_delete(lv_obj_get_child(obj, -1));
+        }
+        huge->shown--;
+    }
+
+    memmove(&huge->blocks[1], &huge->blocks[0], huge->shown * sizeof(uint32_t));
+    huge->blocks[0] = n;
+    huge->first--;
+    huge->shown++;
+    huge_window_changed(obj, data);
+
+    if(n > 0 && old_first != NULL) {
+        lv_obj_update_layout(obj);
+        int32_t dy = lv_obj_get_y(old_first) - lv_obj_get_y(lv_obj_get_child(obj, 0));
+        if(dy > 0) lv_obj_scroll_by(huge->scroller, 0, -dy, LV_ANIM_OFF);
+    }
+}
+
+/**
+ * Slide the window when scrolling stops near one of its ends.
+ */
+static void huge_scroll_end_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = (lv_obj_t *)lv_event_get_user_data(e);
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->huge == NULL || data->huge->busy) return;
+
+    lv_markdown_huge_t * huge = data->huge;
+    lv_obj_t * scroller = huge->scroller;
+    int32_t reach = lv_obj_get_content_height(scroller);
+
+    huge->busy = 1;
+    if(lv_obj_get_scroll_bottom(scroller) < reach && huge->first + huge->shown < huge->mark_cnt) {
+        huge_slide_down(obj, data);
+    }
+    else if(lv_obj_get_scroll_top(scroller) < reach && huge->first > 0) {
+        huge_slide_up(obj, data);
+    }
+    huge->busy = 0;
+}
+
+/* --- Internal API --- */
+
+void lv_markdown_huge_delete(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    lv_markdown_huge_t * huge = data->huge;
+    if(huge == NULL) return;
+
+    if(huge->scroller != NULL) {
+        lv_obj_remove_event_cb_with_user_data(huge->scroller, huge_scroll_end_cb, obj);
+    }
+    lv_free(huge->marks);
+    lv_free(huge);
+    data->huge = NULL;
+}
+
+void lv_markdown_huge_rerender(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    huge_show(obj, data, data->huge->first);
+}
+
+/* --- Public API --- */
+
+lv_result_t lv_markdown_set_text_huge(lv_obj_t * obj, const char * text, size_t len, uint32_t mark_lines)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return LV_RESULT_INVALID;
+
+    /* Clears the content and leaves log or huge-document mode */
+    lv_markdown_set_text(obj, NULL);
+    if(text == NULL) return LV_RESULT_INVALID;
+
+    lv_markdown_huge_t * huge = (lv_markdown_huge_t *)lv_calloc(1, sizeof(lv_markdown_huge_t));
+    if(huge == NULL) return LV_RESULT_INVALID;
+
+    huge->text = text;
+    huge->len  = len;
+    if(huge_index(huge, mark_lines ? mark_lines : 1000) != LV_RESULT_OK) {
+        lv_free(huge->marks);
+        lv_free(huge);
+        return LV_RESULT_INVALID;
+    }
+    data->huge = huge;
+
+    lv_obj_t * scroller = lv_obj_get_parent(obj);
+    while(scroller != NULL && !lv_obj_has_flag(scroller, LV_OBJ_FLAG_SCROLLABLE)) {
+        scroller = lv_obj_get_parent(scroller);
+    }
+    if(scroller != NULL) {
+        lv_obj_add_event_cb(scroller, huge_scroll_end_cb, LV_EVENT_SCROLL_END, obj);
+        huge->scroller = scroller;
+    }
+
+    huge_show(obj, data, 0);
+    return LV_RESULT_OK;
+}
+
+void lv_markdown_huge_show_line(lv_obj_t * obj, uint64_t line)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->huge == NULL) return;
+
+    /* Last mark at or before the line */
+    lv_markdown_huge_t * huge = data->huge;
+    uint32_t lo = 0;
+    uint32_t hi = huge->mark_cnt;
+    while(hi - lo > 1) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if(huge->marks[mid].line <= line) lo = mid;
+        else hi = mid;
+    }
+
+    huge_show(obj, data, lo);
+    if(huge->scroller == NULL) return;
+
+    /* First block of the section at the top of the view */
+    uint32_t idx = 0;
+    for(uint32_t i = 0; i < lo - huge->first; i++) idx += huge->blocks[i];
+    lv_obj_t * block = lv_obj_get_child(obj, (int32_t)idx);
+    if(block == NULL) return;
+
+    lv_obj_update_layout(huge->scroller);
+    lv_area_t a;
+    lv_area_t v;
+    lv_obj_get_coords(block, &a);
+    lv_obj_get_coords(huge->scroller, &v);
+    int32_t view_top = v.y1 + lv_obj_get_style_border_width(huge->scroller, 0) +
+                       lv_obj_get_style_pad_top(huge->scroller, 0);
+    huge->busy = 1;
+    lv_obj_scroll_to_y(huge->scroller, a.y1 - view_top + lv_obj_get_scroll_y(huge->scroller), LV_ANIM_OFF);
+    huge->busy = 0;
+}
+
+uint64_t lv_markdown_huge_get_first_line(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->huge == NULL) return 0;
+
+    return data->huge->marks[data->huge->first].line;
+}
+
+uint64_t lv_markdown_huge_get_line_count(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->huge == NULL) return 0;
+
+    return data->huge->line_cnt;
+}
+
+uint32_t lv_markdown_huge_get_mark_count(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->huge == NULL) return 0;
+
+    return data->huge->mark_cnt;
+}
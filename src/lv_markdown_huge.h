@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_huge.h
+ * @brief Huge-document mode: show a window of a very large document
+ *
+ * For documents too large to parse and build at once (generated reports of
+ * hundreds of MB). The text stays where the caller has it, e.g. mmap'd.
+ * One pass over it builds a sparse line index with 64-bit offsets: a mark
+ * every `mark_lines` lines, placed at a block boundary. The widget shows a
+ * window of LV_MARKDOWN_HUGE_WINDOW sections between marks, and md4c only
+ * ever sees one section, so memory grows with the window, not the document.
+ *
+ * When the nearest scrollable ancestor stops scrolling near either end of
+ * the window, it slides by one section and the view is adjusted so the
+ * visible lines stay in place.
+ */
+
+#ifndef LV_MARKDOWN_HUGE_H
+#define LV_MARKDOWN_HUGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+/** Sections shown at once */
+#ifndef LV_MARKDOWN_HUGE_WINDOW
+#define LV_MARKDOWN_HUGE_WINDOW 3
+#endif
+
+/** Sections longer than this are cut at the last blank line, or inside a block if there is none */
+#ifndef LV_MARKDOWN_HUGE_SECTION_MAX
+#define LV_MARKDOWN_HUGE_SECTION_MAX (1024 * 1024)
+#endif
+
+/**
+ * Show a huge document. The text is not copied and must stay valid until
+ * other text is set or the widget is deleted; it needn't be NUL-terminated.
+ * Shows the start of the document. lv_markdown_get_text returns NULL in
+ * this mode. Link reference definitions only apply within a section.
+ *
+ * @param obj           pointer to a markdown widget
+ * @param text          markdown source
+ * @param len           length of text in bytes
+ * @param mark_lines    lines between index marks (0 = 1000); sections
+ *                      are at least this long, up to the next block
+ * @return              LV_RESULT_OK, or LV_RESULT_INVALID if out of memory
+ */
+lv_result_t lv_markdown_set_text_huge(lv_obj_t * obj, const char * text, size_t len, uint32_t mark_lines);
+
+/**
+ * Move the window to a line and scroll its section to the top.
+ *
+ * @param obj       pointer to a markdown widget in huge-document mode
+ * @param line      0-based line number
+ */
+void lv_markdown_huge_show_line(lv_obj_t * obj, uint64_t line);
+
+/**
+ * Get the first line of the window, e.g. to draw a position indicator.
+ *
+ * @param obj       pointer to a markdown widget in huge-document mode
+ * @return          0-based line number, 0 if not in huge-document mode
+ */
+uint64_t lv_markdown_huge_get_first_line(lv_obj_t * obj);
+
+/**
+ * Get the number of lines in the document.
+ *
+ * @param obj       pointer to a markdown widget in huge-document mode
+ * @return          line count, 0 if not in huge-document mode
+ */
+uint64_t lv_markdown_huge_get_line_count(lv_obj_t * obj);
+
+/**
+ * Get the number of index marks (sections).
+ *
+ * @param obj       pointer to a markdown widget in huge-document mode
+ * @return          mark count, 0 if not in huge-document mode
+ */
+uint32_t lv_markdown_huge_get_mark_count(lv_obj_t * obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_HUGE_H */
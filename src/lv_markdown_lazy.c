@@ -0,0 +1,188 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_lazy.c
+ * @brief Building at the next frame: lazy and coalescing widgets
+ *
+ * A lazy widget keeps only its text until it is shown; a coalescing widget
+ * keeps only its latest text until the next frame. Waiting widgets are
+ * listed here. At LV_EVENT_REFR_START of their display, before LVGL lays
+ * out and draws the frame, coalescing widgets and lazy ones in view are
+ * built, so the frame shows their content. Building one can push others
+ * into view, so the check repeats until nothing more is built.
+ *
+ * LV_EVENT_REFR_READY counts frames, which tells the update statistics
+ * whether a tree was replaced before any frame showed it.
+ */
+
+#include "lv_markdown_private.h"
+
+#include <string.h>
+
+/* --- Internal data --- */
+
+static lv_obj_t ** lazy_list;       /**< Widgets waiting to be shown */
+static uint32_t    lazy_cnt;
+static uint32_t    lazy_cap;
+static uint32_t    lazy_frame;      /**< Frames drawn, on any display */
+
+static void lazy_remove(uint32_t idx)
+{
+    memmove(&lazy_list[idx], &lazy_list[idx + 1], (lazy_cnt - idx - 1) * sizeof(lv_obj_t *));
+    lazy_cnt--;
+    if(lazy_cnt == 0) {
+        lv_free(lazy_list);
+        lazy_list = NULL;
+        lazy_cap  = 0;
+    }
+}
+
+/* --- Display hook --- */
+
+static void lazy_refr_start_cb(lv_event_t * e)
+{
+    lv_display_t * disp = (lv_display_t *)lv_event_get_target(e);
+
+    bool built = true;
+    while(built && lazy_cnt > 0) {
+        built = false;
+        lv_obj_update_layout(lv_display_get_screen_active(disp));
+
+        uint32_t i = 0;
+        while(i < lazy_cnt) {
+            lv_obj_t * obj = lazy_list[i];
+            lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+            if(lv_obj_get_display(obj) != disp || (data->lazy && !lv_markdown_in_view(obj))) {
+                i++;
+                continue;
+            }
+
+            lazy_remove(i);
+            data->lazy_pending = 0;
+            lv_markdown_sched_cancel(obj, data);
+            lv_markdown_rebuild(obj, data);
+            built = true;
+        }
+    }
+}
+
+static void lazy_refr_ready_cb(lv_event_t * e)
+{
+    (void)e;
+    lazy_frame++;
+}
+
+/* --- Internal API --- */
+
+void lv_markdown_lazy_hook_display(lv_display_t * disp)
+{
+    /* Once per display. The hooks stay, like the scheduler's timer */
+    uint32_t cnt = lv_display_get_event_count(disp);
+    for(uint32_t i = 0; i < cnt; i++) {
+        if(lv_event_dsc_get_cb(lv_display_get_event_dsc(disp, i)) == lazy_refr_start_cb) return;
+    }
+    lv_display_add_event_cb(disp, lazy_refr_start_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, lazy_refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+}
+
+uint32_t lv_markdown_lazy_get_frame(void)
+{
+    return lazy_frame;
+}
+
+bool lv_markdown_lazy_defer(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(!(data->lazy || data->coalesce) || data->log != NULL || data->huge != NULL) return false;
+    if(data->lazy_pending) return true;
+
+    lv_display_t * disp = lv_obj_get_display(obj);
+    if(disp == NULL) return false;
+
+    if(lazy_cnt == lazy_cap) {
+        uint32_t new_cap = lazy_cap ? lazy_cap * 2 : 16;
+        lv_obj_t ** list = (lv_obj_t **)lv_realloc(lazy_list, new_cap * sizeof(lv_obj_t *));
+        /* Out of memory: build right away */
+        if(list == NULL) return false;
+        lazy_list = list;
+        lazy_cap  = new_cap;
+    }
+
+    lv_markdown_lazy_hook_display(disp);
+    lazy_list[lazy_cnt++] = obj;
+    data->lazy_pending = 1;
+
+    /* Make sure a refresh comes, even if nothing else changes */
+    lv_obj_mark_layout_as_dirty(obj);
+    return true;
+}
+
+void lv_markdown_lazy_cancel(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(!data->lazy_pending) return;
+
+    for(uint32_t i = 0; i < lazy_cnt; i++) {
+        if(lazy_list[i] == obj) {
+            lazy_remove(i);
+            break;
+        }
+    }
+    data->lazy_pending = 0;
+}
+
+/* --- Public API --- */
+
+void lv_markdown_set_lazy(lv_obj_t * obj, bool en)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    data->lazy = en;
+    if(!en && !data->coalesce && data->lazy_pending) {
+        lv_markdown_lazy_cancel(obj, data);
+        lv_markdown_rerender(obj, data);
+    }
+}
+
+bool lv_markdown_get_lazy(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return false;
+
+    return data->lazy;
+}
+
+void lv_markdown_set_coalesce(lv_obj_t * obj, bool en)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    data->coalesce = en;
+    if(!en && !data->lazy && data->lazy_pending) {
+        lv_markdown_lazy_cancel(obj, data);
+        lv_markdown_rerender(obj, data);
+    }
+}
+
+bool lv_markdown_get_coalesce(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return false;
+
+    return data->coalesce;
+}
+
+void lv_markdown_build(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    lv_markdown_build_pending(obj, data);
+}
+
+bool lv_markdown_is_built(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return false;
+
+    return !data->lazy_pending && !data->sched_pending;
+}
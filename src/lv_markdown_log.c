@@ -0,0 +1,395 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_log.c
+ * @brief Log mode: appended chunks in a bounded ring
+ *
+ * Each lv_markdown_append() call is one chunk: its source is copied into a
+ * byte ring and parsed on its own, and its blocks are added after the
+ * existing children. When a limit is exceeded, blocks are deleted from the
+ * head; a chunk's bytes are reclaimed once all of its blocks are gone.
+ *
+ * The byte ring keeps every chunk contiguous (a chunk that doesn't fit
+ * before the end of the buffer starts again at offset 0), so chunks can be
+ * re-parsed in place when the style changes.
+ *
+ * Link reference definitions are shared across chunks through
+ * lv_markdown_refs.c; a new or changed definition re-renders only the
+ * chunks that reference its label.
+ */
+
+#include "lv_markdown_private.h"
+
+#include <string.h>
+
+/* --- Internal data --- */
+
+typedef struct {
+    uint32_t off;       /**< Source offset in the byte ring */
+    uint32_t len;       /**< Source length */
+    uint32_t blocks;    /**< Blocks of this chunk still shown */
+    uint32_t skip;      /**< Leading blocks of this chunk already trimmed */
+    uint8_t  dirty;     /**< A definition it references changed */
+} log_chunk_t;
+
+struct lv_markdown_log_t {
+    char *        buf;          /**< Byte ring */
+    uint32_t      cap;          /**< Size of buf */
+    log_chunk_t * chunks;       /**< Chunk ring, power-of-two capacity */
+    uint32_t      chunk_cap;
+    uint32_t      chunk_head;   /**< Index of the oldest chunk */
+    uint32_t      chunk_cnt;
+    uint32_t      bytes;        /**< Source bytes held */
+    uint32_t      blocks;       /**< Blocks shown */
+    uint32_t      max_blocks;   /**< 0 = unlimited */
+    uint32_t      max_bytes;    /**< 0 = unlimited (the ring grows) */
+    uint32_t      head_seq;     /**< Sequence number of the oldest chunk */
+    uint32_t      dirty_cnt;    /**< Chunks waiting for a re-render */
+    lv_markdown_refs_t * refs;  /**< Reference definitions across chunks */
+};
+
+static inline log_chunk_t * chunk_at(lv_markdown_log_t * log, uint32_t i)
+{
+    return &log->chunks[(log->chunk_head + i) & (log->chunk_cap - 1)];
+}
+
+/* --- Chunk ring --- */
+
+static int chunk_push(lv_markdown_log_t * log, const log_chunk_t * c)
+{
+    if(log->chunk_cnt == log->chunk_cap) {
+        uint32_t new_cap = log->chunk_cap ? log->chunk_cap * 2 : 16;
+        log_chunk_t * chunks = (log_chunk_t *)lv_malloc(new_cap * sizeof(log_chunk_t));
+        if(chunks == NULL) return 0;
+        for(uint32_t i = 0; i < log->chunk_cnt; i++) chunks[i] = *chunk_at(log, i);
+        lv_free(log->chunks);
+        log->chunks     = chunks;
+        log->chunk_cap  = new_cap;
+        log->chunk_head = 0;
+    }
+    *chunk_at(log, log->chunk_cnt) = *c;
+    log->chunk_cnt++;
+    return 1;
+}
+
+static void chunk_pop(lv_markdown_log_t * log)
+{
+    log_chunk_t * c = chunk_at(log, 0);
+    log->bytes -= c->len;
+    if(c->dirty) log->dirty_cnt--;
+    log->chunk_head = (log->chunk_head + 1) & (log->chunk_cap - 1);
+    log->chunk_cnt--;
+    log->head_seq++;
+}
+
+/* --- Rendering --- */
+
+/**
+ * Render a chunk after the current children, with the reference
+ * definitions it needs from other chunks. Blocks trimmed earlier stay
+ * trimmed.
+ *
+ * @return number of blocks added
+ */
+static uint32_t log_render_chunk(lv_obj_t * obj, lv_markdown_data_t * data, const log_chunk_t * c)
+{
+    lv_markdown_log_t * log = data->log;
+    const char * chunk_src = log->buf + c->off;
+    uint32_t before = lv_obj_get_child_count(obj);
+
+    uint32_t len;
+    const char * src = lv_markdown_refs_source(log->refs, chunk_src, c->len, &len);
+    lv_markdown_render_into(obj, &data->style, data->draw_profile, src, len);
+    lv_markdown_refs_source_free(chunk_src, src);
+
+    for(uint32_t k = 0; k < c->skip && lv_obj_get_child_count(obj) > before; k++) {
+        lv_obj_delete(lv_obj_get_child(obj, (int32_t)before));
+    }
+    return lv_obj_get_child_count(obj) - before;
+}
+
+static void log_mark_dirty(uint32_t seq, void * user_data)
+{
+    lv_markdown_log_t * log = (lv_markdown_log_t *)user_data;
+
+    /* The newest chunk was just rendered with the new definitions */
+    uint32_t i = seq - log->head_seq;
+    if(i + 1 >= log->chunk_cnt) return;
+
+    log_chunk_t * c = chunk_at(log, i);
+    if(!c->dirty) {
+        c->dirty = 1;
+        log->dirty_cnt++;
+    }
+}
+
+/**
+ * Re-render the dirty chunks in place. Other blocks are not touched.
+ */
+static void log_refresh_dirty(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    lv_markdown_log_t * log = data->log;
+
+    uint32_t start = 0;
+    for(uint32_t i = 0; i < log->chunk_cnt && log->dirty_cnt > 0; i++) {
+        log_chunk_t * c = chunk_at(log, i);
+        if(c->dirty) {
+            c->dirty = 0;
+            log->dirty_cnt--;
+
+            lv_markdown_zoom_blocks_removed(obj, data, start, c->blocks);
+            for(uint32_t k = 0; k < c->blocks; k++) {
+                lv_obj_delete(lv_obj_get_child(obj, (int32_t)start));
+            }
+            uint32_t before = lv_obj_get_child_count(obj);
+            uint32_t n = log_render_chunk(obj, data, c);
+            for(uint32_t k = 0; k < n; k++) {
+                lv_obj_move_to_index(lv_obj_get_child(obj, (int32_t)(before + k)), (int32_t)(start + k));
+            }
+            lv_markdown_zoom_blocks_added(obj, data, start, n);
+
+            log->blocks = log->blocks - c->blocks + n;
+            c->blocks   = n;
+        }
+        start += c->blocks;
+    }
+
+    if(log->blocks > 0) lv_obj_set_style_margin_top(lv_obj_get_child(obj, 0), 0, 0);
+}
+
+/* --- Trimming --- */
+
+/**
+ * Delete `n` blocks from the head. If the view is scrolled into the log,
+ * it is scrolled back by the removed height so the visible lines stay put.
+ *
+ * The chunk and byte rings are released in O(1), but LVGL keeps children
+ * in an array, so each deleted block still shifts the remaining pointers.
+ */
+static void log_drop_blocks(lv_obj_t * obj, lv_markdown_log_t * log, uint32_t n)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    if(n > child_cnt) n = child_cnt;
+    if(n == 0) return;
+
+    /* Height of the removed blocks, from an up-to-date layout: blocks
+     * appended since the last refresh have no coordinates yet */
+    lv_obj_update_layout(obj);
+    lv_obj_t * first = lv_obj_get_child(obj, 0);
+    lv_obj_t * survivor = n < child_cnt ? lv_obj_get_child(obj, (int32_t)n) : NULL;
+    int32_t dy = survivor != NULL ? lv_obj_get_y(survivor) - lv_obj_get_y(first) : 0;
+
+    lv_markdown_zoom_blocks_removed(obj, data, 0, n);
+    for(uint32_t i = 0; i < n; i++) {
+        lv_obj_delete(lv_obj_get_child(obj, 0));
+    }
+
+    /* The new first block starts flush, like the first block of a document */
+    if(survivor != NULL) lv_obj_set_style_margin_top(survivor, 0, 0);
+
+    /* Release chunks whose blocks are all gone */
+    uint32_t left = n;
+    while(log->chunk_cnt > 0) {
+        log_chunk_t * c = chunk_at(log, 0);
+        uint32_t k = LV_MIN(left, c->blocks);
+        c->blocks -= k;
+        c->skip   += k;
+        log->blocks -= k;
+        left -= k;
+        if(c->blocks > 0) break;
+        chunk_pop(log);
+    }
+
+    /* A view following the tail is moved once the new height is known */
+    if(dy > 0 && !(data->follow_scroller != NULL && data->follow_attached)) {
+        lv_obj_t * scroller = lv_obj_get_parent(obj);
+        while(scroller != NULL && !lv_obj_has_flag(scroller, LV_OBJ_FLAG_SCROLLABLE)) {
+            scroller = lv_obj_get_parent(scroller);
+        }
+        if(scroller != NULL) {
+            int32_t top = lv_obj_get_scroll_top(scroller);
+            if(top > 0) lv_obj_scroll_by(scroller, 0, LV_MIN(dy, top), LV_ANIM_OFF);
+        }
+    }
+}
+
+/**
+ * Move the chunks to the start of a larger byte ring (unlimited bytes only).
+ */
+static int log_grow(lv_markdown_log_t * log, uint32_t need)
+{
+    uint32_t new_cap = log->cap ? log->cap : 256;
+    while(new_cap < (log->bytes + need) * 2) new_cap *= 2;
+
+    char * buf = (char *)lv_malloc(new_cap);
+    if(buf == NULL) return 0;
+
+    uint32_t off = 0;
+    for(uint32_t i = 0; i < log->chunk_cnt; i++) {
+        log_chunk_t * c = chunk_at(log, i);
+        memcpy(buf + off, log->buf + c->off, c->len);
+        c->off = off;
+        off += c->len;
+    }
+
+    lv_free(log->buf);
+    log->buf = buf;
+    log->cap = new_cap;
+    return 1;
+}
+
+/**
+ * Find a contiguous place for `len` bytes, trimming old chunks (or
+ * growing the ring) as needed.
+ *
+ * @return offset in the ring, or UINT32_MAX if it can't be made to fit
+ */
+static uint32_t log_reserve(lv_obj_t * obj, lv_markdown_log_t * log, uint32_t len)
+{
+    if(log->max_bytes != 0 && len > log->max_bytes) return UINT32_MAX;
+
+    while(1) {
+        if(log->max_bytes == 0 || log->bytes + len <= log->max_bytes) {
+            if(log->chunk_cnt == 0) {
+                if(log->cap >= len) return 0;
+            }
+            else {
+                log_chunk_t * last = chunk_at(log, log->chunk_cnt - 1);
+                uint32_t head = chunk_at(log, 0)->off;
+                uint32_t tail = last->off + last->len;
+                if(tail > head) {
+                    /* [head, tail) used: room after tail, else before head */
+                    if(log->cap - tail >= len) return tail;
+                    if(head >= len) return 0;
+                }
+                else if(head - tail >= len) {
+                    /* Wrapped: room between tail and head */
+                    return tail;
+                }
+            }
+        }
+
+        if(log->max_bytes == 0) {
+            if(!log_grow(log, len)) return UINT32_MAX;
+            continue;
+        }
+        if(log->chunk_cnt == 0) return UINT32_MAX;
+
+        /* Drop the oldest chunk entirely */
+        uint32_t blocks = chunk_at(log, 0)->blocks;
+        if(blocks > 0) log_drop_blocks(obj, log, blocks);
+        else chunk_pop(log);
+    }
+}
+
+/* --- Internal API --- */
+
+void lv_markdown_log_delete(lv_markdown_data_t * data)
+{
+    lv_markdown_log_t * log = data->log;
+    if(log == NULL) return;
+
+    lv_markdown_refs_delete(log->refs);
+    lv_free(log->buf);
+    lv_free(log->chunks);
+    lv_free(log);
+    data->log = NULL;
+}
+
+void lv_markdown_log_rerender(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    lv_markdown_log_t * log = data->log;
+
+    lv_markdown_phase_t prev = lv_markdown_alloc_set_phase(LV_MARKDOWN_PHASE_CLEAR);
+    lv_obj_clean(obj);
+    lv_markdown_alloc_set_phase(prev);
+
+    log->blocks    = 0;
+    log->dirty_cnt = 0;
+    for(uint32_t i = 0; i < log->chunk_cnt; i++) {
+        log_chunk_t * c = chunk_at(log, i);
+        c->dirty  = 0;
+        c->blocks = log_render_chunk(obj, data, c);
+        log->blocks += c->blocks;
+    }
+
+    if(log->blocks > 0) lv_obj_set_style_margin_top(lv_obj_get_child(obj, 0), 0, 0);
+    data->block_count = log->blocks;
+    lv_markdown_zoom_tree_changed(obj, data);
+}
+
+/* --- Public API --- */
+
+void lv_markdown_set_log_mode(lv_obj_t * obj, uint32_t max_blocks, uint32_t max_bytes)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    /* Clears the content and leaves any previous log mode */
+    lv_markdown_set_text(obj, NULL);
+    if(max_blocks == 0 && max_bytes == 0) return;
+
+    lv_markdown_log_t * log = (lv_markdown_log_t *)lv_calloc(1, sizeof(lv_markdown_log_t));
+    if(log == NULL) return;
+
+    log->refs = lv_markdown_refs_create();
+    if(log->refs == NULL) {
+        lv_free(log);
+        return;
+    }
+
+    log->max_blocks = max_blocks;
+    log->max_bytes  = max_bytes;
+    if(max_bytes != 0) {
+        /* Fixed ring: allocated once, never grows */
+        log->buf = (char *)lv_malloc(max_bytes);
+        if(log->buf == NULL) {
+            lv_markdown_refs_delete(log->refs);
+            lv_free(log);
+            return;
+        }
+        log->cap = max_bytes;
+    }
+    data->log = log;
+}
+
+lv_result_t lv_markdown_append(lv_obj_t * obj, const char * text)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->log == NULL || text == NULL) return LV_RESULT_INVALID;
+
+    lv_markdown_log_t * log = data->log;
+    size_t len = strlen(text);
+    if(len == 0) return LV_RESULT_OK;
+    if(len >= UINT32_MAX / 4) return LV_RESULT_INVALID;
+
+    uint32_t off = log_reserve(obj, log, (uint32_t)len);
+    if(off == UINT32_MAX) return LV_RESULT_INVALID;
+    memcpy(log->buf + off, text, len);
+
+    uint32_t seq = log->head_seq + log->chunk_cnt;
+    lv_markdown_refs_scan(log->refs, seq, log->head_seq, log->buf + off, (uint32_t)len);
+
+    uint32_t before = lv_obj_get_child_count(obj);
+    log_chunk_t c = { off, (uint32_t)len, 0, 0, 0 };
+    c.blocks = log_render_chunk(obj, data, &c);
+    if(!chunk_push(log, &c)) {
+        while(lv_obj_get_child_count(obj) > before) lv_obj_delete(lv_obj_get_child(obj, (int32_t)before));
+        return LV_RESULT_INVALID;
+    }
+    log->bytes  += c.len;
+    log->blocks += c.blocks;
+    lv_markdown_zoom_blocks_added(obj, data, before, c.blocks);
+
+    if(log->max_blocks != 0 && log->blocks > log->max_blocks) {
+        log_drop_blocks(obj, log, log->blocks - log->max_blocks);
+    }
+
+    /* Earlier chunks whose references this chunk (re)defined */
+    lv_markdown_refs_take_changed(log->refs, log->head_seq, log_mark_dirty, log);
+    if(log->dirty_cnt > 0) log_refresh_dirty(obj, data);
+
+    data->block_count = log->blocks;
+    return LV_RESULT_OK;
+}
@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_md4c_alloc.h
+ * @brief Route md4c's allocations through lv_malloc
+ *
+ * Included by md4c.c when built with
+ *   -DMD4C_ALLOC_HEADER='"lv_markdown_md4c_alloc.h"'
+ * so the parser's temporary buffers come from the LVGL heap and show up
+ * in lv_markdown's allocation statistics. Not for use elsewhere.
+ */
+
+#ifndef LV_MARKDOWN_MD4C_ALLOC_H
+#define LV_MARKDOWN_MD4C_ALLOC_H
+
+#include <stddef.h>
+
+void * lv_markdown_md4c_malloc(size_t size);
+void * lv_markdown_md4c_realloc(void * p, size_t size);
+void lv_markdown_md4c_free(void * p);
+
+#define malloc(size)        lv_markdown_md4c_malloc(size)
+#define realloc(p, size)    lv_markdown_md4c_realloc(p, size)
+#define free(p)             lv_markdown_md4c_free(p)
+
+#endif /* LV_MARKDOWN_MD4C_ALLOC_H */
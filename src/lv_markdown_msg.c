@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown_msg.h"
+#include "lv_markdown_private.h"
+#include <string.h>
+
+/* --- Internal data --- */
+
+/**
+ * Per-message data: a length header with the text stored inline in the
+ * same allocation. Nothing else is kept per message; style and parser
+ * configuration are shared.
+ */
+typedef struct {
+    uint32_t len;       /**< Text length in bytes (excluding NUL) */
+    char     text[];    /**< NUL-terminated text */
+} lv_markdown_msg_data_t;
+
+/* --- Shared state --- */
+
+static const lv_markdown_style_t * shared_style;
+static lv_markdown_style_t         default_style;
+static uint8_t                     default_style_ready;
+
+static const lv_markdown_style_t * msg_get_style(void)
+{
+    if(shared_style != NULL) return shared_style;
+
+    if(!default_style_ready) {
+        lv_markdown_style_init(&default_style);
+        default_style_ready = 1;
+    }
+    return &default_style;
+}
+
+/* --- Plain text detection --- */
+
+/**
+ * Conservatively decide whether text renders identically without parsing:
+ * a single line with no character that can open a block or an inline span.
+ */
+static int msg_is_plain(const char * text, uint32_t len)
+{
+    if(len == 0) return 1;
+
+    /* Block openers (lists, quotes, indented code) and trimmed whitespace */
+    char first = text[0];
+    if(first == ' ' || first == '\t' || first == '-' || first == '+' ||
+       first == '>' || (first >= '0' && first <= '9')) {
+        return 0;
+    }
+    char last = text[len - 1];
+    if(last == ' ' || last == '\t') return 0;
+
+    for(uint32_t i = 0; i < len; i++) {
+        switch(text[i]) {
+            case '\n':
+            case '\r':
+            case '\\':
+            case '`':
+            case '*':
+            case '_':
+            case '~':
+            case '[':
+            case '<':
+            case '&':
+            case '#':
+                return 0;
+            default:
+                break;
+        }
+    }
+    return 1;
+}
+
+/* --- Rendering --- */
+
+static void msg_render(lv_obj_t * obj, lv_markdown_msg_data_t * data)
+{
+    const lv_markdown_style_t * style = msg_get_style();
+
+    if(msg_is_plain(data->text, data->len)) {
+        /* Single label pointing at the message's own copy of the text */
+        lv_obj_t * label = lv_label_create(obj);
+        lv_obj_set_width(label, LV_PCT(100));
+        lv_label_set_text_static(label, data->text);
+        lv_obj_set_style_text_font(label, style->body_font, 0);
+        lv_obj_set_style_text_color(label, style->body_color, 0);
+        lv_obj_set_style_text_line_space(label, style->line_spacing, 0);
+        return;
+    }
+
+    lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_COLUMN);
+    lv_markdown_render_into(obj, style, LV_MARKDOWN_DRAW_PROFILE_DEFAULT, data->text, data->len);
+}
+
+/* --- Cleanup event handler --- */
+
+static void lv_markdown_msg_delete_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_markdown_msg_data_t * data = (lv_markdown_msg_data_t *)lv_obj_get_user_data(obj);
+    if(data != NULL) {
+        lv_free(data);
+        lv_obj_set_user_data(obj, NULL);
+    }
+}
+
+/* --- Public API --- */
+
+lv_obj_t * lv_markdown_msg_create(lv_obj_t * parent)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    if(obj == NULL) return NULL;
+
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_width(obj, LV_PCT(100));
+    lv_obj_set_height(obj, LV_SIZE_CONTENT);
+
+    /* Data is allocated on first set_text, sized to the message */
+    lv_obj_add_event_cb(obj, lv_markdown_msg_delete_cb, LV_EVENT_DELETE, NULL);
+
+    return obj;
+}
+
+void lv_markdown_msg_set_text(lv_obj_t * obj, const char * text)
+{
+    lv_markdown_msg_data_t * data = (lv_markdown_msg_data_t *)lv_obj_get_user_data(obj);
+
+    /* Children may reference data->text, so drop them before resizing */
+    lv_obj_clean(obj);
+
+    if(text == NULL) {
+        if(data != NULL) lv_free(data);
+        lv_obj_set_user_data(obj, NULL);
+        return;
+    }
+
+    size_t len = strlen(text);
+    if(len > UINT32_MAX - sizeof(lv_markdown_msg_data_t) - 1) return;
+
+    lv_markdown_msg_data_t * new_data =
+        (lv_markdown_msg_data_t *)lv_realloc(data, sizeof(lv_markdown_msg_data_t) + len + 1);
+    if(new_data == NULL) return;
+
+    new_data->len = (uint32_t)len;
+    memcpy(new_data->text, text, len + 1);
+    lv_obj_set_user_data(obj, new_data);
+
+    msg_render(obj, new_data);
+}
+
+const char * lv_markdown_msg_get_text(lv_obj_t * obj)
+{
+    lv_markdown_msg_data_t * data = (lv_markdown_msg_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return NULL;
+
+    return data->text;
+}
+
+void lv_markdown_msg_set_shared_style(const lv_markdown_style_t * style)
+{
+    shared_style = style;
+}
+
+size_t lv_markdown_msg_get_data_size(lv_obj_t * obj)
+{
+    lv_markdown_msg_data_t * data = (lv_markdown_msg_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return 0;
+
+    return sizeof(lv_markdown_msg_data_t) + data->len + 1;
+}
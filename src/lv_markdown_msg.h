@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_msg.h
+ * @brief Compact markdown widget for large numbers of short messages
+ *
+ * A message widget renders like lv_markdown but is built for chat-style
+ * histories with thousands of instances:
+ *   - all messages share one style (set once, not copied per widget)
+ *   - the text lives in a single allocation sized to the message
+ *   - plain text (no markdown syntax) becomes one static-text label
+ *     without running the parser at all
+ */
+
+#ifndef LV_MARKDOWN_MSG_H
+#define LV_MARKDOWN_MSG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+#include "lv_markdown_style.h"
+
+/**
+ * Create a compact message widget.
+ * Like lv_markdown_create, it is full width and grows to fit its content.
+ *
+ * @param parent    pointer to the parent object
+ * @return          pointer to the created message widget
+ */
+lv_obj_t * lv_markdown_msg_create(lv_obj_t * parent);
+
+/**
+ * Set the message text. The text is copied.
+ * Messages without markdown syntax skip parsing and render as one label.
+ *
+ * @param obj       pointer to a message widget
+ * @param text      markdown string (NULL to clear)
+ */
+void lv_markdown_msg_set_text(lv_obj_t * obj, const char * text);
+
+/**
+ * Get the message text.
+ *
+ * @param obj       pointer to a message widget
+ * @return          the markdown string, or NULL if none set
+ */
+const char * lv_markdown_msg_get_text(lv_obj_t * obj);
+
+/**
+ * Set the style shared by all message widgets.
+ * The style is NOT copied and must stay valid while messages exist.
+ * Only affects messages rendered afterwards.
+ *
+ * @param style     pointer to a style, or NULL for lv_markdown_style_init defaults
+ */
+void lv_markdown_msg_set_shared_style(const lv_markdown_style_t * style);
+
+/**
+ * Get the number of bytes a message owns outside its LVGL objects
+ * (bookkeeping + text), for overhead accounting.
+ *
+ * @param obj       pointer to a message widget
+ * @return          owned bytes, or 0 if none
+ */
+size_t lv_markdown_msg_get_data_size(lv_obj_t * obj);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_MSG_H */
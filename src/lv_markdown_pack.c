@@ -0,0 +1,285 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown_pack.h"
+#include "lv_markdown.h"
+
+#include <string.h>
+
+/* --- Internal data --- */
+
+struct lv_markdown_pack_t {
+    const uint8_t * data;       /**< Whole pack for array packs, NULL for files */
+    uint8_t *       index;      /**< Header + index + id table (heap copy for files, == data for arrays) */
+    uint32_t        size;       /**< Pack size in bytes */
+    uint32_t        count;      /**< Number of documents */
+    uint32_t        entry_size; /**< Bytes per index entry */
+    uint32_t        names_off;  /**< Offset of the id table */
+    uint32_t        names_size; /**< Size of the id table */
+    uint8_t         is_file;    /**< 1 = documents are read through `file` */
+    lv_fs_file_t    file;       /**< Open pack file */
+};
+
+/* --- Little-endian readers --- */
+
+static inline uint16_t rd16(const uint8_t * p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t rd32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* --- Index access --- */
+
+typedef struct {
+    uint32_t id_hash;
+    uint32_t id_off;
+    uint32_t id_len;
+    uint8_t  format;
+    uint32_t doc_off;
+    uint32_t doc_len;
+    uint32_t doc_hash;
+} pack_entry_t;
+
+static void read_entry(const lv_markdown_pack_t * pack, uint32_t idx, pack_entry_t * e)
+{
+    const uint8_t * p = pack->index + LV_MARKDOWN_PACK_HEADER_SIZE + (size_t)idx * pack->entry_size;
+    e->id_hash  = rd32(p + 0);
+    e->id_off   = rd32(p + 4);
+    e->id_len   = rd16(p + 8);
+    e->format   = p[10];
+    e->doc_off  = rd32(p + 12);
+    e->doc_len  = rd32(p + 16);
+    e->doc_hash = rd32(p + 20);
+}
+
+static const char * entry_id(const lv_markdown_pack_t * pack, const pack_entry_t * e)
+{
+    return (const char *)pack->index + pack->names_off + e->id_off;
+}
+
+/**
+ * Parse the header. `hdr` must hold LV_MARKDOWN_PACK_HEADER_SIZE bytes.
+ * Sets the count, entry size and id table location.
+ */
+static int parse_header(lv_markdown_pack_t * pack, const uint8_t * hdr)
+{
+    if(memcmp(hdr, LV_MARKDOWN_PACK_MAGIC, 4) != 0) return 0;
+    if(rd16(hdr + 4) != LV_MARKDOWN_PACK_VERSION) return 0;
+
+    pack->entry_size = rd16(hdr + 6);
+    pack->count      = rd32(hdr + 8);
+    pack->names_size = rd32(hdr + 12);
+    if(pack->entry_size < LV_MARKDOWN_PACK_ENTRY_SIZE) return 0;
+
+    uint64_t names_off = LV_MARKDOWN_PACK_HEADER_SIZE + (uint64_t)pack->count * pack->entry_size;
+    if(names_off + pack->names_size > pack->size) return 0;
+    pack->names_off = (uint32_t)names_off;
+    return 1;
+}
+
+/**
+ * Check that every id is a NUL-terminated string in the id table and
+ * every document lies in the pack, so lookups and loads need no checks.
+ */
+static int validate_index(const lv_markdown_pack_t * pack)
+{
+    const char * names = (const char *)pack->index + pack->names_off;
+    uint32_t docs_start = pack->names_off + pack->names_size;
+
+    for(uint32_t i = 0; i < pack->count; i++) {
+        pack_entry_t e;
+        read_entry(pack, i, &e);
+
+        if((uint64_t)e.id_off + e.id_len >= pack->names_size) return 0;
+        if(names[e.id_off + e.id_len] != '\0') return 0;
+
+        /* Room for the document and its NUL */
+        if(e.doc_off < docs_start || (uint64_t)e.doc_off + e.doc_len >= pack->size) return 0;
+        if(pack->data != NULL && pack->data[e.doc_off + e.doc_len] != '\0') return 0;
+    }
+    return 1;
+}
+
+/* --- Public API --- */
+
+lv_markdown_pack_t * lv_markdown_pack_open_array(const void * data, uint32_t size)
+{
+    if(data == NULL || size < LV_MARKDOWN_PACK_HEADER_SIZE) return NULL;
+
+    lv_markdown_pack_t * pack = (lv_markdown_pack_t *)lv_calloc(1, sizeof(lv_markdown_pack_t));
+    if(pack == NULL) return NULL;
+
+    pack->data  = (const uint8_t *)data;
+    pack->index = (uint8_t *)data;
+    pack->size  = size;
+
+    if(!parse_header(pack, pack->data) || !validate_index(pack)) {
+        lv_free(pack);
+        return NULL;
+    }
+    return pack;
+}
+
+lv_markdown_pack_t * lv_markdown_pack_open(const char * path)
+{
+    if(path == NULL) return NULL;
+
+    lv_markdown_pack_t * pack = (lv_markdown_pack_t *)lv_calloc(1, sizeof(lv_markdown_pack_t));
+    if(pack == NULL) return NULL;
+
+    if(lv_fs_open(&pack->file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        lv_free(pack);
+        return NULL;
+    }
+    pack->is_file = 1;
+
+    uint32_t size = 0;
+    uint32_t br = 0;
+    uint8_t hdr[LV_MARKDOWN_PACK_HEADER_SIZE];
+    if(lv_fs_seek(&pack->file, 0, LV_FS_SEEK_END) != LV_FS_RES_OK ||
+       lv_fs_tell(&pack->file, &size) != LV_FS_RES_OK ||
+       lv_fs_seek(&pack->file, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK ||
+       lv_fs_read(&pack->file, hdr, sizeof(hdr), &br) != LV_FS_RES_OK || br != sizeof(hdr)) {
+        lv_markdown_pack_close(pack);
+        return NULL;
+    }
+
+    pack->size = size;
+    if(!parse_header(pack, hdr)) {
+        lv_markdown_pack_close(pack);
+        return NULL;
+    }
+
+    /* Only the header, index and ids are kept in RAM */
+    uint32_t index_size = pack->names_off + pack->names_size;
+    pack->index = (uint8_t *)lv_malloc(index_size);
+    if(pack->index == NULL) {
+        lv_markdown_pack_close(pack);
+        return NULL;
+    }
+    memcpy(pack->index, hdr, sizeof(hdr));
+
+    uint32_t rest = index_size - (uint32_t)sizeof(hdr);
+    if(lv_fs_read(&pack->file, pack->index + sizeof(hdr), rest, &br) != LV_FS_RES_OK || br != rest ||
+       !validate_index(pack)) {
+        lv_markdown_pack_close(pack);
+        return NULL;
+    }
+    return pack;
+}
+
+void lv_markdown_pack_close(lv_markdown_pack_t * pack)
+{
+    if(pack == NULL) return;
+
+    if(pack->is_file) {
+        lv_fs_close(&pack->file);
+        lv_free(pack->index);
+    }
+    lv_free(pack);
+}
+
+uint32_t lv_markdown_pack_get_count(const lv_markdown_pack_t * pack)
+{
+    return pack != NULL ? pack->count : 0;
+}
+
+int32_t lv_markdown_pack_find(const lv_markdown_pack_t * pack, const char * id)
+{
+    if(pack == NULL || id == NULL) return -1;
+
+    uint32_t hash = lv_markdown_pack_hash(id, strlen(id));
+
+    /* Lower bound on the id hash; the index is sorted by it */
+    uint32_t lo = 0;
+    uint32_t hi = pack->count;
+    while(lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if(rd32(pack->index + LV_MARKDOWN_PACK_HEADER_SIZE + (size_t)mid * pack->entry_size) < hash) lo = mid + 1;
+        else hi = mid;
+    }
+
+    for(uint32_t i = lo; i < pack->count; i++) {
+        pack_entry_t e;
+        read_entry(pack, i, &e);
+        if(e.id_hash != hash) break;
+        if(strcmp(entry_id(pack, &e), id) == 0) return (int32_t)i;
+    }
+    return -1;
+}
+
+const char * lv_markdown_pack_get_id(const lv_markdown_pack_t * pack, uint32_t idx)
+{
+    if(pack == NULL || idx >= pack->count) return NULL;
+
+    pack_entry_t e;
+    read_entry(pack, idx, &e);
+    return entry_id(pack, &e);
+}
+
+uint32_t lv_markdown_pack_get_hash(const lv_markdown_pack_t * pack, uint32_t idx)
+{
+    if(pack == NULL || idx >= pack->count) return 0;
+
+    pack_entry_t e;
+    read_entry(pack, idx, &e);
+    return e.doc_hash;
+}
+
+const char * lv_markdown_pack_load(lv_markdown_pack_t * pack, uint32_t idx, uint32_t * len)
+{
+    if(pack == NULL || idx >= pack->count) return NULL;
+
+    pack_entry_t e;
+    read_entry(pack, idx, &e);
+    if(e.format != LV_MARKDOWN_PACK_FORMAT_TEXT) return NULL;
+
+    if(!pack->is_file) {
+        if(len != NULL) *len = e.doc_len;
+        return (const char *)pack->data + e.doc_off;
+    }
+
+    char * text = (char *)lv_malloc((size_t)e.doc_len + 1);
+    if(text == NULL) return NULL;
+
+    uint32_t br = 0;
+    if(lv_fs_seek(&pack->file, e.doc_off, LV_FS_SEEK_SET) != LV_FS_RES_OK ||
+       lv_fs_read(&pack->file, text, e.doc_len, &br) != LV_FS_RES_OK || br != e.doc_len ||
+       lv_markdown_pack_hash(text, e.doc_len) != e.doc_hash) {
+        lv_free(text);
+        return NULL;
+    }
+    text[e.doc_len] = '\0';
+
+    if(len != NULL) *len = e.doc_len;
+    return text;
+}
+
+void lv_markdown_pack_unload(lv_markdown_pack_t * pack, const char * text)
+{
+    if(pack == NULL || text == NULL) return;
+
+    /* Array documents are used in place */
+    if(pack->is_file) lv_free((void *)text);
+}
+
+lv_result_t lv_markdown_set_text_from_pack(lv_obj_t * obj, lv_markdown_pack_t * pack, const char * id)
+{
+    int32_t idx = lv_markdown_pack_find(pack, id);
+    if(idx < 0) return LV_RESULT_INVALID;
+
+    const char * text = lv_markdown_pack_load(pack, (uint32_t)idx, NULL);
+    if(text == NULL) return LV_RESULT_INVALID;
+
+    if(pack->is_file) {
+        lv_markdown_set_text(obj, text);
+        lv_markdown_pack_unload(pack, text);
+    }
+    else {
+        lv_markdown_set_text_static(obj, text);
+    }
+    return LV_RESULT_OK;
+}
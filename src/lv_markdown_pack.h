@@ -0,0 +1,124 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_pack.h
+ * @brief Indexed packs of markdown documents, loaded on demand
+ *
+ * A pack (built on the host by tools/md_pack) holds many documents behind
+ * an index of id, offset, length and content hash. Opening a pack reads
+ * only the index; a document is read when it is requested.
+ *
+ * Packs can come from a file through lv_fs, or from a const array linked
+ * into flash. Documents in an array are used in place, without copying.
+ */
+
+#ifndef LV_MARKDOWN_PACK_H
+#define LV_MARKDOWN_PACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+#include "lv_markdown_pack_format.h"
+
+typedef struct lv_markdown_pack_t lv_markdown_pack_t;
+
+/**
+ * Open a pack file. Reads and checks the header and index; documents stay
+ * on disk until loaded, and the file stays open until the pack is closed.
+ *
+ * @param path      lv_fs path, e.g. "S:help.pack"
+ * @return          the pack, or NULL if it can't be read or is malformed
+ */
+lv_markdown_pack_t * lv_markdown_pack_open(const char * path);
+
+/**
+ * Open a pack held in memory (e.g. a const array from md_pack -c).
+ *
+ * @param data      pack bytes, must stay valid while the pack is open
+ * @param size      size of data in bytes
+ * @return          the pack, or NULL if malformed or out of memory
+ */
+lv_markdown_pack_t * lv_markdown_pack_open_array(const void * data, uint32_t size);
+
+/**
+ * Close a pack. Documents loaded from a file must be unloaded first.
+ *
+ * @param pack      pointer to a pack
+ */
+void lv_markdown_pack_close(lv_markdown_pack_t * pack);
+
+/**
+ * Get the number of documents.
+ *
+ * @param pack      pointer to a pack
+ * @return          number of documents
+ */
+uint32_t lv_markdown_pack_get_count(const lv_markdown_pack_t * pack);
+
+/**
+ * Look up a document by id.
+ *
+ * @param pack      pointer to a pack
+ * @param id        document id as given to md_pack
+ * @return          index of the document, or -1 if not found
+ */
+int32_t lv_markdown_pack_find(const lv_markdown_pack_t * pack, const char * id);
+
+/**
+ * Get a document's id.
+ *
+ * @param pack      pointer to a pack
+ * @param idx       document index
+ * @return          NUL-terminated id, owned by the pack, or NULL if idx is out of range
+ */
+const char * lv_markdown_pack_get_id(const lv_markdown_pack_t * pack, uint32_t idx);
+
+/**
+ * Get a document's content hash, without loading it.
+ *
+ * @param pack      pointer to a pack
+ * @param idx       document index
+ * @return          lv_markdown_pack_hash of the document text, 0 if idx is out of range
+ */
+uint32_t lv_markdown_pack_get_hash(const lv_markdown_pack_t * pack, uint32_t idx);
+
+/**
+ * Load a document. From an array this returns the text in place; from a
+ * file it reads the text into a new buffer and checks it against the
+ * index hash.
+ *
+ * @param pack      pointer to a pack
+ * @param idx       document index
+ * @param len       receives the text length (may be NULL)
+ * @return          NUL-terminated markdown, to be released with
+ *                  lv_markdown_pack_unload; NULL on error or unknown format
+ */
+const char * lv_markdown_pack_load(lv_markdown_pack_t * pack, uint32_t idx, uint32_t * len);
+
+/**
+ * Release a document returned by lv_markdown_pack_load.
+ *
+ * @param pack      pointer to a pack
+ * @param text      the loaded text (NULL is ignored)
+ */
+void lv_markdown_pack_unload(lv_markdown_pack_t * pack, const char * text);
+
+/**
+ * Show a document from a pack in a markdown widget. Array packs are shown
+ * with lv_markdown_set_text_static (no copy), file packs are loaded,
+ * copied into the widget and released.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param pack      pointer to a pack (an array pack must outlive the widget's text)
+ * @param id        document id
+ * @return          LV_RESULT_OK, or LV_RESULT_INVALID if not found or not loadable
+ */
+lv_result_t lv_markdown_set_text_from_pack(lv_obj_t * obj, lv_markdown_pack_t * pack, const char * id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_PACK_H */
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_pack_format.h
+ * @brief On-disk layout of markdown document packs
+ *
+ * Shared by the loader (lv_markdown_pack.c) and the host packer
+ * (tools/md_pack.c), so it depends on nothing but the C library.
+ * All integers are little-endian.
+ *
+ *   header      LV_MARKDOWN_PACK_HEADER_SIZE bytes
+ *     0  magic       "LVMP"
+ *     4  u16 version LV_MARKDOWN_PACK_VERSION
+ *     6  u16 entry   size of one index entry (>= LV_MARKDOWN_PACK_ENTRY_SIZE)
+ *     8  u32 count   number of documents
+ *    12  u32 names   size of the id table in bytes
+ *   index       count entries, sorted by (id hash, id)
+ *     0  u32 id_hash    lv_markdown_pack_hash of the id
+ *     4  u32 id_off     offset of the id in the id table
+ *     8  u16 id_len     id length, without its NUL
+ *    10  u8  format     LV_MARKDOWN_PACK_FORMAT_*
+ *    11  u8  reserved   0
+ *    12  u32 doc_off    offset of the document from the start of the pack
+ *    16  u32 doc_len    document length, without its NUL
+ *    20  u32 doc_hash   lv_markdown_pack_hash of the document
+ *   id table    NUL-terminated ids
+ *   documents   NUL-terminated, at doc_off
+ */
+
+#ifndef LV_MARKDOWN_PACK_FORMAT_H
+#define LV_MARKDOWN_PACK_FORMAT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LV_MARKDOWN_PACK_MAGIC          "LVMP"
+#define LV_MARKDOWN_PACK_VERSION        1
+#define LV_MARKDOWN_PACK_HEADER_SIZE    16
+#define LV_MARKDOWN_PACK_ENTRY_SIZE     24
+
+/** Document encodings. Loaders skip entries with a format they don't know. */
+#define LV_MARKDOWN_PACK_FORMAT_TEXT    0   /**< Markdown source */
+
+/**
+ * FNV-1a, used for ids and document contents.
+ */
+static inline uint32_t lv_markdown_pack_hash(const void * data, size_t len)
+{
+    const uint8_t * p = (const uint8_t *)data;
+    uint32_t h = 2166136261u;
+    for(size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_PACK_FORMAT_H */
@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown_prerender.h"
+
+#if LV_USE_IMAGE
+
+lv_obj_t * lv_markdown_prerendered_create(lv_obj_t * parent, const lv_markdown_prerendered_t * doc)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    if(obj == NULL) return NULL;
+
+    lv_obj_remove_style_all(obj);
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+    if(doc == NULL) return obj;
+
+    lv_obj_set_size(obj, doc->w, doc->h);
+
+    /* Absolute positions from the host render: no flex, no text layout */
+    for(uint32_t i = 0; i < doc->block_cnt; i++) {
+        const lv_markdown_prerendered_block_t * b = &doc->blocks[i];
+        lv_obj_t * img = lv_image_create(obj);
+        if(img == NULL) break;
+        lv_image_set_src(img, b->img);
+        lv_obj_set_pos(img, b->x, b->y);
+    }
+
+    return obj;
+}
+
+#endif /* LV_USE_IMAGE */
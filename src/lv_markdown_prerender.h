@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_prerender.h
+ * @brief Display markdown rasterized at build time by tools/md_prerender
+ *
+ * For static screens (boot notices, legal text) with fixed fonts and width,
+ * md_prerender runs the renderer on the host and emits the result as C
+ * arrays: one image for the whole document, or one image per top-level
+ * block plus its position. Showing it needs no parsing and no layout.
+ *
+ * Requires LV_USE_IMAGE.
+ */
+
+#ifndef LV_MARKDOWN_PRERENDER_H
+#define LV_MARKDOWN_PRERENDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+#if LV_USE_IMAGE
+
+/** One rasterized block (or the whole document) */
+typedef struct {
+    int32_t                x;       /**< Offset from the document's left edge */
+    int32_t                y;       /**< Offset from the document's top edge */
+    const lv_image_dsc_t * img;     /**< Pixels */
+} lv_markdown_prerendered_block_t;
+
+/** A document as emitted by md_prerender */
+typedef struct {
+    int32_t                                 w;          /**< Document width in pixels */
+    int32_t                                 h;          /**< Document height in pixels */
+    uint32_t                                block_cnt;  /**< Entries in blocks */
+    const lv_markdown_prerendered_block_t * blocks;     /**< Images in top-to-bottom order */
+} lv_markdown_prerendered_t;
+
+/** Declare a document generated by md_prerender, like LV_IMAGE_DECLARE */
+#define LV_MARKDOWN_PRERENDERED_DECLARE(name) extern const lv_markdown_prerendered_t name
+
+/**
+ * Create an object showing a pre-rendered document.
+ * Images are placed at their recorded positions; nothing is parsed or laid out.
+ *
+ * @param parent    pointer to the parent object
+ * @param doc       generated document, must stay valid (normally const data)
+ * @return          pointer to the created object, sized to the document
+ */
+lv_obj_t * lv_markdown_prerendered_create(lv_obj_t * parent, const lv_markdown_prerendered_t * doc);
+
+#endif /* LV_USE_IMAGE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_PRERENDER_H */
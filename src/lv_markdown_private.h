@@ -0,0 +1,434 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_private.h
+ * @brief Internal interfaces shared between lv_markdown source files
+ *
+ * Not part of the public API.
+ */
+
+#ifndef LV_MARKDOWN_PRIVATE_H
+#define LV_MARKDOWN_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lv_markdown.h"
+#include "lv_markdown_bidi.h"
+
+/* --- Span text arena (see lv_markdown_arena.c) --- */
+
+typedef struct lv_markdown_arena_block_t lv_markdown_arena_block_t;
+
+typedef struct {
+    lv_markdown_arena_block_t * head;   /**< Block being filled, NULL = empty */
+    uint32_t next_size;                 /**< Capacity of the next block */
+} lv_markdown_arena_t;
+
+/**
+ * Size the first block of an empty arena, e.g. from the document length,
+ * so a whole document's span text usually takes one allocation.
+ *
+ * @param arena     arena
+ * @param size      expected bytes
+ */
+void lv_markdown_arena_reserve(lv_markdown_arena_t * arena, uint32_t size);
+
+/**
+ * Get `size` bytes that stay valid until the arena is freed.
+ *
+ * @param arena     arena
+ * @param size      bytes to allocate
+ * @return          pointer to the bytes, or NULL if out of memory
+ */
+char * lv_markdown_arena_alloc(lv_markdown_arena_t * arena, uint32_t size);
+
+/**
+ * Free every block at once. Spans referring to the arena must be gone.
+ *
+ * @param arena     arena
+ */
+void lv_markdown_arena_free(lv_markdown_arena_t * arena);
+
+/* --- Font roles (see lv_markdown_zoom.c) --- */
+
+/** What a font set by the renderer stands for, so zoom can swap it by role */
+typedef enum {
+    LV_MARKDOWN_FONT_BODY = 0,
+    LV_MARKDOWN_FONT_H1,            /**< H1..H6 follow in order */
+    LV_MARKDOWN_FONT_BOLD = LV_MARKDOWN_FONT_H1 + 6,
+    LV_MARKDOWN_FONT_ITALIC,
+    LV_MARKDOWN_FONT_BOLD_ITALIC,
+    LV_MARKDOWN_FONT_CODE,
+} lv_markdown_font_role_t;
+
+/**
+ * Style property holding an object's or span's lv_markdown_font_role_t.
+ * Registered with LVGL on first use.
+ *
+ * @return          the property
+ */
+lv_style_prop_t lv_markdown_font_role_prop(void);
+
+/* --- Widget data (attached as user_data) --- */
+
+typedef struct lv_markdown_log_t lv_markdown_log_t;
+typedef struct lv_markdown_refs_t lv_markdown_refs_t;
+typedef struct lv_markdown_huge_t lv_markdown_huge_t;
+
+typedef struct {
+    char *                 text;        /**< Owned copy of markdown text (NULL if static) */
+    const char *           text_ptr;    /**< Pointer to current text (owned or static) */
+    uint8_t                is_static;   /**< 1 if text_ptr points to caller-owned memory */
+    lv_markdown_style_t    style;       /**< Rendering style config */
+    lv_markdown_draw_profile_t draw_profile; /**< Active draw-cost profile */
+    uint32_t               block_count; /**< Number of top-level blocks */
+    lv_markdown_arena_t    arena;       /**< Span text of the current tree (lv_markdown_render only) */
+
+    /* Preview (see lv_markdown_set_preview_limits) */
+    uint32_t               preview_max_blocks; /**< 0 = no limit */
+    uint32_t               preview_max_chars;  /**< 0 = no limit */
+    uint8_t                preview_truncated;  /**< 1 = the tree ends with the ellipsis */
+
+    /* UTF-8 check (see lv_markdown_utf8.c) */
+    lv_markdown_utf8_policy_t utf8_policy;    /**< Applied by the next set_text */
+    uint8_t                utf8_invalid;      /**< 1 = the text had invalid sequences */
+    uint8_t                text_ascii;        /**< 1 = the text is known to be ASCII only */
+
+    /* Zoom (see lv_markdown_zoom.c) */
+    const lv_markdown_style_t * zoom_levels;  /**< Style per zoom level (not owned), NULL = off */
+    uint32_t               zoom_level_count;  /**< Number of entries in zoom_levels */
+    uint32_t               zoom_level;        /**< Active zoom level */
+    uint32_t               zoom_block_cnt;    /**< Top-level children tracked below */
+    uint16_t *             zoom_block_level;  /**< Level each block's fonts are at */
+    int32_t *              zoom_heights;      /**< [block * zoom_level_count + level] height, -1 = unknown */
+    uint32_t               zoom_pinned_cnt;   /**< Blocks waiting for a re-wrap */
+    lv_obj_t *             zoom_scroll_parent; /**< Where the deferred re-wrap handler is attached */
+
+    /* Log mode (see lv_markdown_log.c) */
+    lv_markdown_log_t *    log;               /**< Appended chunks, NULL = not in log mode */
+
+    /* Huge-document mode (see lv_markdown_huge.c) */
+    lv_markdown_huge_t *   huge;              /**< Index and window, NULL = not in huge-document mode */
+
+    /* Follow tail (see lv_markdown_follow.c) */
+    lv_obj_t *             follow_scroller;   /**< Scrollable ancestor kept at the bottom, NULL = off */
+    int32_t                follow_h;          /**< Widget height at the last size change */
+    uint8_t                follow_attached;   /**< 0 while scrolled away from the bottom */
+    uint8_t                follow_busy;       /**< 1 while the view is moved by us */
+
+    /* Restored view (see lv_markdown_state.c) */
+    lv_obj_t *             state_scroller;    /**< Where the unpin handler is attached, NULL = none */
+    int32_t                state_width;       /**< Width the pinned heights are valid at */
+    uint32_t               state_pinned_cnt;  /**< Blocks still at a saved height */
+
+    uint8_t                sched_pending;     /**< 1 = queued in the scheduler (see lv_markdown_sched.c) */
+    uint32_t               sched_order;       /**< When it was queued, orders widgets at equal distance */
+
+    /* Building at the next frame (see lv_markdown_lazy.c) */
+    uint8_t                lazy;              /**< 1 = build when first shown */
+    uint8_t                coalesce;          /**< 1 = build once per frame */
+    uint8_t                lazy_pending;      /**< 1 = text set, tree not built yet */
+    lv_markdown_update_stats_t stats;         /**< Counted since create / reset */
+    uint32_t               built_frame;       /**< Frame count when the tree was built */
+
+#if LV_USE_BIDI
+    lv_markdown_bidi_cache_t bidi_cache;      /**< Visual-order runs of the current text */
+    uint8_t                bidi_cache_off;    /**< 1 = let LVGL process every run itself */
+#endif
+} lv_markdown_data_t;
+
+/* --- Block handler registry (see lv_markdown_registry.c) --- */
+
+typedef struct {
+    lv_markdown_block_type_t    type;
+    const char *                lang;           /**< NULL = any language */
+    lv_markdown_block_handler_t handler;        /**< NULL = free slot */
+    int32_t                     placeholder_h;  /**< >0 = lazy */
+    void *                      user_data;
+} lv_markdown_handler_entry_t;
+
+/**
+ * Find the handler for a block. An exact language match wins over a
+ * handler registered for any language.
+ *
+ * @param type      block type
+ * @param lang      fence language (need not be NUL-terminated), or NULL
+ * @param lang_len  length of lang in bytes
+ * @return          the handler entry, or NULL to use the built-in rendering
+ */
+const lv_markdown_handler_entry_t * lv_markdown_find_block_handler(lv_markdown_block_type_t type,
+                                                                   const char * lang, uint32_t lang_len);
+
+/**
+ * Build a block with a handler, or create its placeholder if the handler is lazy.
+ *
+ * @param parent    container to create the block in
+ * @param h         handler entry from lv_markdown_find_block_handler
+ * @param block     the parsed block (copied if lazy)
+ * @return          the created top object, or NULL
+ */
+lv_obj_t * lv_markdown_run_block_handler(lv_obj_t * parent, const lv_markdown_handler_entry_t * h,
+                                         const lv_markdown_block_t * block);
+
+/**
+ * Parse markdown and append the resulting blocks to a container.
+ * The container should use a column flex flow; existing children are kept.
+ *
+ * @param container pointer to the object receiving the blocks
+ * @param style     style to render with (must stay valid during the call)
+ * @param profile   draw-cost profile
+ * @param text      markdown source (need not be NUL-terminated)
+ * @param len       length of text in bytes
+ * @return          number of top-level blocks created
+ */
+uint32_t lv_markdown_render_into(lv_obj_t * container, const lv_markdown_style_t * style,
+                                 lv_markdown_draw_profile_t profile, const char * text, size_t len);
+
+/**
+ * Clear the widget's children and render its current text again.
+ * Does nothing if no text is set.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_rerender(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Like lv_markdown_rerender, but always right away.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_rebuild(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Build a widget now if it waits for the scheduler or to be shown.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_build_pending(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/* --- Scheduler (see lv_markdown_sched.c) --- */
+
+/**
+ * Queue a widget for building if the scheduler is on.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ * @return          true if queued (or already queued), false to build now
+ */
+bool lv_markdown_sched_defer(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Remove a widget from the queue, e.g. when it is cleared or deleted.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_sched_cancel(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Check whether any part of a widget is shown, taking a widget without
+ * content as its top line.
+ *
+ * @param obj       pointer to a markdown widget
+ * @return          true if visible on an active screen
+ */
+bool lv_markdown_in_view(lv_obj_t * obj);
+
+/* --- Lazy building (see lv_markdown_lazy.c) --- */
+
+/**
+ * Hold off building a lazy widget until it is shown, or a coalescing
+ * one until the next frame.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ * @return          true if waiting (or already waiting), false to build now
+ */
+bool lv_markdown_lazy_defer(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Watch a display's refreshes, once per display. Called for every new
+ * widget, so frames are counted for the update statistics.
+ *
+ * @param disp      display
+ */
+void lv_markdown_lazy_hook_display(lv_display_t * disp);
+
+/**
+ * Get the number of frames drawn so far.
+ *
+ * @return          frame count, on any display
+ */
+uint32_t lv_markdown_lazy_get_frame(void);
+
+/**
+ * Stop waiting, e.g. when the widget is cleared or deleted.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_lazy_cancel(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Re-sync zoom bookkeeping after the widget tree was rebuilt or cleared.
+ * All blocks are then at the active zoom level and cached heights are stale.
+ * Trees changed in part use lv_markdown_zoom_blocks_removed/_added instead.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_zoom_tree_changed(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Forget the zoom bookkeeping of top-level blocks about to be deleted.
+ * Call before deleting them; the other blocks keep their levels and heights.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ * @param idx       index of the first block to be deleted
+ * @param cnt       number of blocks to be deleted
+ */
+void lv_markdown_zoom_blocks_removed(lv_obj_t * obj, lv_markdown_data_t * data, uint32_t idx, uint32_t cnt);
+
+/**
+ * Track top-level blocks just rendered with the active style at `idx`.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ * @param idx       index of the first new block
+ * @param cnt       number of new blocks
+ */
+void lv_markdown_zoom_blocks_added(lv_obj_t * obj, lv_markdown_data_t * data, uint32_t idx, uint32_t cnt);
+
+/**
+ * Rebuild the widget tree from the log's chunks, e.g. after a style change.
+ * Blocks trimmed from the head stay trimmed.
+ *
+ * @param obj       pointer to a markdown widget in log mode
+ * @param data      its widget data
+ */
+void lv_markdown_log_rerender(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Leave log mode and free the ring. Does not touch the widget's children.
+ *
+ * @param data      widget data
+ */
+void lv_markdown_log_delete(lv_markdown_data_t * data);
+
+/**
+ * Release blocks pinned by lv_markdown_restore_state and detach its
+ * handlers, e.g. before the widget tree is rebuilt.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_state_reset(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Re-render the sections in the window, e.g. after a style change.
+ *
+ * @param obj       pointer to a markdown widget in huge-document mode
+ * @param data      its widget data
+ */
+void lv_markdown_huge_rerender(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Leave huge-document mode and free the index. Does not touch the
+ * widget's children.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_huge_delete(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/* --- Reference definitions across chunks (see lv_markdown_refs.c) --- */
+
+/**
+ * Create an empty reference definition index.
+ *
+ * @return          the index, or NULL if out of memory
+ */
+lv_markdown_refs_t * lv_markdown_refs_create(void);
+
+/**
+ * Free an index (NULL is ignored).
+ *
+ * @param refs      pointer to an index
+ */
+void lv_markdown_refs_delete(lv_markdown_refs_t * refs);
+
+/**
+ * Record the definitions and references of a new chunk. Changed
+ * definitions are reported by lv_markdown_refs_take_changed.
+ *
+ * @param refs      pointer to an index (NULL is ignored)
+ * @param seq       sequence number of the chunk
+ * @param oldest    sequence number of the oldest chunk still shown
+ * @param src       chunk source
+ * @param len       length of src
+ */
+void lv_markdown_refs_scan(lv_markdown_refs_t * refs, uint32_t seq, uint32_t oldest,
+                           const char * src, uint32_t len);
+
+/**
+ * Get the text to parse for a chunk: the chunk itself, followed by the
+ * indexed definitions of the labels it references.
+ *
+ * @param refs      pointer to an index (NULL: src is returned)
+ * @param src       chunk source
+ * @param len       length of src
+ * @param out_len   receives the length of the returned text
+ * @return          src, or a new buffer to be released with lv_markdown_refs_source_free
+ */
+const char * lv_markdown_refs_source(lv_markdown_refs_t * refs, const char * src, uint32_t len,
+                                     uint32_t * out_len);
+
+/**
+ * Release the text returned by lv_markdown_refs_source.
+ *
+ * @param src       the chunk source passed to lv_markdown_refs_source
+ * @param buf       its return value
+ */
+void lv_markdown_refs_source_free(const char * src, const char * buf);
+
+/**
+ * Report the chunks that reference a label whose definition changed since
+ * the last call, then clear the changes. Definitions made by chunks older
+ * than `oldest` are dropped first, which counts as a change.
+ *
+ * @param refs      pointer to an index (NULL is ignored)
+ * @param oldest    sequence number of the oldest chunk still shown
+ * @param cb        called with the sequence number of each referencing chunk
+ *                  (a chunk referencing several changed labels is reported once per label)
+ * @param user_data passed to cb
+ */
+void lv_markdown_refs_take_changed(lv_markdown_refs_t * refs, uint32_t oldest,
+                                   void (*cb)(uint32_t seq, void * user_data), void * user_data);
+
+/**
+ * Stop following the tail and remove the event handlers.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_follow_reset(lv_obj_t * obj, lv_markdown_data_t * data);
+
+/**
+ * Turn zoom support off and release its bookkeeping.
+ *
+ * @param obj       pointer to a markdown widget
+ * @param data      its widget data
+ */
+void lv_markdown_zoom_reset(lv_obj_t * obj, lv_markdown_data_t * data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_PRIVATE_H */
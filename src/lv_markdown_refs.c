@@ -0,0 +1,537 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_refs.c
+ * @brief Persistent link reference definition index for appended chunks
+ *
+ * md4c resolves `[text][label]` only against definitions in the text it is
+ * given. In log mode every chunk is parsed on its own, so this index keeps
+ * the definitions of the chunks still shown and, per label, the chunks that
+ * reference it. A chunk is parsed with the definitions it needs appended to
+ * its source, and a new, changed or dropped definition re-renders only the
+ * referencing chunks.
+ *
+ * Definitions and references are found with a line scanner that follows
+ * the CommonMark rules closely enough for log-style text: a definition is
+ * a `[label]:` line at the start of a block, and lines in fenced code are
+ * skipped. Labels are matched after ASCII case folding and whitespace
+ * collapsing. Labels longer than REFS_LABEL_MAX still work within one
+ * chunk but are not indexed.
+ */
+
+#include "lv_markdown_private.h"
+
+#include <string.h>
+
+#define REFS_LABEL_MAX  64
+
+/* Slot states; real hashes are remapped above them */
+#define REFS_EMPTY      0u
+#define REFS_TOMB       1u
+
+/* Slots checked for stale entries per scanned chunk */
+#define REFS_SWEEP      4
+
+/* --- Internal data --- */
+
+typedef struct {
+    uint32_t   hash;        /**< Label hash, or REFS_EMPTY / REFS_TOMB */
+    char *     label;       /**< Normalized label */
+    uint32_t   label_len;
+    char *     def;         /**< Definition line including its newline, NULL = undefined */
+    uint32_t   def_len;
+    uint32_t   def_seq;     /**< Chunk holding the definition */
+    uint32_t * seqs;        /**< Chunks referencing the label, ascending */
+    uint32_t   seq_cnt;
+    uint32_t   seq_cap;
+    uint32_t   mark;        /**< Stamp of the last source build that used it */
+    uint8_t    changed;     /**< Definition changed since the last lv_markdown_refs_take_changed */
+} refs_label_t;
+
+typedef struct {
+    uint32_t     seq;       /**< Chunk holding the definition */
+    const char * label;     /**< Normalized label, owned by its slot */
+} refs_def_t;
+
+struct lv_markdown_refs_t {
+    refs_label_t * slots;   /**< Open addressing, power-of-two capacity */
+    uint32_t       cap;
+    uint32_t       used;    /**< Live slots */
+    uint32_t       tombs;   /**< Deleted slots */
+    uint32_t       changed_cnt;
+    uint32_t       sweep;   /**< Next slot to check for stale entries */
+    uint32_t       stamp;
+    refs_def_t *   defs;    /**< Definitions by chunk, oldest first (ring, power-of-two capacity) */
+    uint32_t       def_head;
+    uint32_t       def_cnt;
+    uint32_t       def_cap;
+};
+
+typedef void (*refs_def_cb_t)(void * ctx, const char * label, uint32_t label_len,
+                              const char * line, uint32_t line_len);
+typedef void (*refs_ref_cb_t)(void * ctx, const char * label, uint32_t label_len);
+
+/* --- Labels --- */
+
+/**
+ * Case-fold (ASCII) and collapse whitespace. Returns the normalized length,
+ * 0 if the label is blank or too long to be indexed.
+ */
+static uint32_t refs_normalize(const char * label, uint32_t len, char * out)
+{
+    uint32_t n = 0;
+    bool space = false;
+    for(uint32_t i = 0; i < len; i++) {
+        char ch = label[i];
+        if(ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+            space = n > 0;
+            continue;
+        }
+        if(space) {
+            if(n == REFS_LABEL_MAX) return 0;
+            out[n++] = ' ';
+            space = false;
+        }
+        if(n == REFS_LABEL_MAX) return 0;
+        out[n++] = (ch >= 'A' && ch <= 'Z') ? (char)(ch + 'a' - 'A') : ch;
+    }
+    return n;
+}
+
+static uint32_t refs_hash(const char * s, uint32_t len)
+{
+    uint32_t h = 2166136261u;
+    for(uint32_t i = 0; i < len; i++) {
+        h ^= (uint8_t)s[i];
+        h *= 16777619u;
+    }
+    return h > REFS_TOMB ? h : h + 2;
+}
+
+/* --- Hash table --- */
+
+static void refs_free_slot(refs_label_t * s)
+{
+    lv_free(s->label);
+    lv_free(s->def);
+    lv_free(s->seqs);
+}
+
+static bool refs_rehash(lv_markdown_refs_t * refs)
+{
+    uint32_t new_cap = 16;
+    while((refs->used + 1) * 2 > new_cap) new_cap *= 2;
+
+    refs_label_t * slots = (refs_label_t *)lv_calloc(new_cap, sizeof(refs_label_t));
+    if(slots == NULL) return false;
+
+    for(uint32_t i = 0; i < refs->cap; i++) {
+        refs_label_t * s = &refs->slots[i];
+        if(s->hash <= REFS_TOMB) continue;
+        uint32_t j = s->hash & (new_cap - 1);
+        while(slots[j].hash != REFS_EMPTY) j = (j + 1) & (new_cap - 1);
+        slots[j] = *s;
+    }
+
+    lv_free(refs->slots);
+    refs->slots = slots;
+    refs->cap   = new_cap;
+    refs->tombs = 0;
+    refs->sweep = 0;
+    return true;
+}
+
+/**
+ * Find a normalized label, optionally adding it.
+ *
+ * @return the slot, or NULL if not found (or out of memory)
+ */
+static refs_label_t * refs_lookup(lv_markdown_refs_t * refs, const char * norm, uint32_t len, bool insert)
+{
+    if(insert && (refs->used + refs->tombs + 1) * 4 > refs->cap * 3) {
+        if(!refs_rehash(refs)) return NULL;
+    }
+    if(refs->cap == 0) return NULL;
+
+    uint32_t hash = refs_hash(norm, len);
+    uint32_t mask = refs->cap - 1;
+    refs_label_t * tomb = NULL;
+    for(uint32_t i = hash & mask;; i = (i + 1) & mask) {
+        refs_label_t * s = &refs->slots[i];
+        if(s->hash == REFS_EMPTY) {
+            if(!insert) return NULL;
+
+            char * label = (char *)lv_malloc(len + 1);
+            if(label == NULL) return NULL;
+            memcpy(label, norm, len);
+            label[len] = '\0';
+
+            if(tomb != NULL) {
+                s = tomb;
+                refs->tombs--;
+            }
+            lv_memzero(s, sizeof(*s));
+            s->hash      = hash;
+            s->label     = label;
+            s->label_len = len;
+            refs->used++;
+            return s;
+        }
+        if(s->hash == REFS_TOMB) {
+            if(tomb == NULL) tomb = s;
+        }
+        else if(s->hash == hash && s->label_len == len && memcmp(s->label, norm, len) == 0) {
+            return s;
+        }
+    }
+}
+
+/**
+ * Drop references from chunks older than `oldest`.
+ */
+static void refs_compact(refs_label_t * s, uint32_t oldest)
+{
+    uint32_t k = 0;
+    while(k < s->seq_cnt && (int32_t)(s->seqs[k] - oldest) < 0) k++;
+    if(k == 0) return;
+
+    memmove(s->seqs, s->seqs + k, (s->seq_cnt - k) * sizeof(uint32_t));
+    s->seq_cnt -= k;
+}
+
+/**
+ * Free a few labels that are neither defined nor referenced any more, so
+ * one-off labels in a long log don't accumulate.
+ */
+static void refs_sweep(lv_markdown_refs_t * refs, uint32_t oldest)
+{
+    for(uint32_t n = 0; n < REFS_SWEEP && n < refs->cap; n++) {
+        refs_label_t * s = &refs->slots[refs->sweep];
+        refs->sweep = (refs->sweep + 1) & (refs->cap - 1);
+        if(s->hash <= REFS_TOMB) continue;
+
+        refs_compact(s, oldest);
+        if(s->seq_cnt == 0 && s->def == NULL && !s->changed) {
+            refs_free_slot(s);
+            lv_memzero(s, sizeof(*s));
+            s->hash = REFS_TOMB;
+            refs->used--;
+            refs->tombs++;
+        }
+    }
+}
+
+/* --- Definitions by chunk --- */
+
+static bool refs_push_def(lv_markdown_refs_t * refs, uint32_t seq, const char * label)
+{
+    if(refs->def_cnt == refs->def_cap) {
+        uint32_t new_cap = refs->def_cap ? refs->def_cap * 2 : 16;
+        refs_def_t * defs = (refs_def_t *)lv_malloc(new_cap * sizeof(refs_def_t));
+        if(defs == NULL) return false;
+        for(uint32_t i = 0; i < refs->def_cnt; i++) {
+            defs[i] = refs->defs[(refs->def_head + i) & (refs->def_cap - 1)];
+        }
+        lv_free(refs->defs);
+        refs->defs     = defs;
+        refs->def_cap  = new_cap;
+        refs->def_head = 0;
+    }
+
+    refs_def_t * d = &refs->defs[(refs->def_head + refs->def_cnt) & (refs->def_cap - 1)];
+    d->seq   = seq;
+    d->label = label;
+    refs->def_cnt++;
+    return true;
+}
+
+/**
+ * Drop definitions made by chunks older than `oldest`. Labels defined again
+ * by a later chunk keep the newer definition.
+ */
+static void refs_trim_defs(lv_markdown_refs_t * refs, uint32_t oldest)
+{
+    while(refs->def_cnt > 0) {
+        refs_def_t * d = &refs->defs[refs->def_head];
+        if((int32_t)(d->seq - oldest) >= 0) break;
+
+        refs_label_t * s = refs_lookup(refs, d->label, (uint32_t)strlen(d->label), false);
+        if(s != NULL && s->def != NULL && s->def_seq == d->seq) {
+            lv_free(s->def);
+            s->def     = NULL;
+            s->def_len = 0;
+            if(!s->changed) {
+                s->changed = 1;
+                refs->changed_cnt++;
+            }
+        }
+        refs->def_head = (refs->def_head + 1) & (refs->def_cap - 1);
+        refs->def_cnt--;
+    }
+}
+
+/* --- Scanner --- */
+
+/**
+ * Match `[label]:` at `p`. Sets the label span on success.
+ */
+static bool refs_match_def(const char * p, const char * eol, const char ** label, uint32_t * label_len)
+{
+    if(p >= eol || *p != '[') return false;
+
+    const char * q = p + 1;
+    while(q < eol && *q != ']' && *q != '[') {
+        if(*q == '\\' && q + 1 < eol) q++;
+        q++;
+    }
+    if(q + 1 >= eol || *q != ']' || q[1] != ':' || q == p + 1) return false;
+
+    *label     = p + 1;
+    *label_len = (uint32_t)(q - (p + 1));
+    return true;
+}
+
+/**
+ * Report every `[label]` on a line. Over-reporting (e.g. the text part of
+ * `[text][label]`) only costs an unused index entry.
+ */
+static void refs_match_refs(const char * p, const char * eol, refs_ref_cb_t ref_cb, void * ctx)
+{
+    while(p < eol) {
+        const char * open = memchr(p, '[', (size_t)(eol - p));
+        if(open == NULL) return;
+        if(open > p && open[-1] == '\\') {
+            p = open + 1;
+            continue;
+        }
+
+        const char * q = open + 1;
+        while(q < eol && *q != ']' && *q != '[') {
+            if(*q == '\\' && q + 1 < eol) q++;
+            q++;
+        }
+        if(q < eol && *q == ']' && q > open + 1) {
+            ref_cb(ctx, open + 1, (uint32_t)(q - open - 1));
+        }
+        p = open + 1;
+    }
+}
+
+/**
+ * Walk the lines of a chunk and report definitions and references.
+ */
+static void refs_walk(const char * src, uint32_t len, refs_def_cb_t def_cb, refs_ref_cb_t ref_cb, void * ctx)
+{
+    const char * p = src;
+    const char * end = src + len;
+    char fence = 0;
+    bool block_start = true;
+
+    while(p < end) {
+        const char * eol = memchr(p, '\n', (size_t)(end - p));
+        if(eol == NULL) eol = end;
+
+        const char * q = p;
+        while(q < eol && *q == ' ' && q - p < 4) q++;
+        bool indented = q - p >= 4;
+
+        const char * t = q;
+        while(t < eol && (*t == ' ' || *t == '\t' || *t == '\r')) t++;
+        bool blank = t == eol;
+
+        if(!indented && eol - q >= 3 && (*q == '`' || *q == '~') && q[1] == *q && q[2] == *q) {
+            if(fence == 0) fence = *q;
+            else if(fence == *q) fence = 0;
+            block_start = fence == 0;
+        }
+        else if(fence == 0) {
+            const char * label;
+            uint32_t label_len;
+            if(block_start && !indented && refs_match_def(q, eol, &label, &label_len)) {
+                if(def_cb != NULL) def_cb(ctx, label, label_len, p, (uint32_t)(eol - p));
+                /* Definitions can follow each other */
+                block_start = true;
+            }
+            else {
+                if(!indented) refs_match_refs(q, eol, ref_cb, ctx);
+                block_start = blank;
+            }
+        }
+
+        p = eol + 1;
+    }
+}
+
+/* --- Scanning a new chunk --- */
+
+typedef struct {
+    lv_markdown_refs_t * refs;
+    uint32_t             seq;
+    uint32_t             oldest;
+} refs_scan_ctx_t;
+
+static void scan_def_cb(void * ctx, const char * label, uint32_t label_len, const char * line, uint32_t line_len)
+{
+    refs_scan_ctx_t * sc = (refs_scan_ctx_t *)ctx;
+    char norm[REFS_LABEL_MAX];
+    uint32_t n = refs_normalize(label, label_len, norm);
+    if(n == 0) return;
+
+    refs_label_t * s = refs_lookup(sc->refs, norm, n, true);
+    if(s == NULL) return;
+
+    /* Unchanged redefinition: nothing to re-render, but it now lives as
+     * long as this chunk */
+    if(s->def != NULL && s->def_len == line_len + 1 && memcmp(s->def, line, line_len) == 0) {
+        if(refs_push_def(sc->refs, sc->seq, s->label)) s->def_seq = sc->seq;
+        return;
+    }
+
+    char * def = (char *)lv_malloc(line_len + 1);
+    if(def == NULL) return;
+    memcpy(def, line, line_len);
+    def[line_len] = '\n';
+
+    /* Only a tracked definition is stored, so it is dropped with its chunk */
+    if(!refs_push_def(sc->refs, sc->seq, s->label)) {
+        lv_free(def);
+        return;
+    }
+
+    lv_free(s->def);
+    s->def     = def;
+    s->def_len = line_len + 1;
+    s->def_seq = sc->seq;
+    if(!s->changed) {
+        s->changed = 1;
+        sc->refs->changed_cnt++;
+    }
+}
+
+static void scan_ref_cb(void * ctx, const char * label, uint32_t label_len)
+{
+    refs_scan_ctx_t * sc = (refs_scan_ctx_t *)ctx;
+    char norm[REFS_LABEL_MAX];
+    uint32_t n = refs_normalize(label, label_len, norm);
+    if(n == 0) return;
+
+    refs_label_t * s = refs_lookup(sc->refs, norm, n, true);
+    if(s == NULL) return;
+    if(s->seq_cnt > 0 && s->seqs[s->seq_cnt - 1] == sc->seq) return;
+
+    if(s->seq_cnt == s->seq_cap) {
+        refs_compact(s, sc->oldest);
+        if(s->seq_cnt == s->seq_cap) {
+            uint32_t new_cap = s->seq_cap ? s->seq_cap * 2 : 4;
+            uint32_t * seqs = (uint32_t *)lv_realloc(s->seqs, new_cap * sizeof(uint32_t));
+            if(seqs == NULL) return;
+            s->seqs    = seqs;
+            s->seq_cap = new_cap;
+        }
+    }
+    s->seqs[s->seq_cnt++] = sc->seq;
+}
+
+/* --- Building a chunk's parse source --- */
+
+typedef struct {
+    lv_markdown_refs_t * refs;
+    char *               out;       /**< NULL: measuring */
+    uint32_t             len;
+} refs_source_ctx_t;
+
+static void source_ref_cb(void * ctx, const char * label, uint32_t label_len)
+{
+    refs_source_ctx_t * sc = (refs_source_ctx_t *)ctx;
+    char norm[REFS_LABEL_MAX];
+    uint32_t n = refs_normalize(label, label_len, norm);
+    if(n == 0) return;
+
+    refs_label_t * s = refs_lookup(sc->refs, norm, n, false);
+    if(s == NULL || s->def == NULL || s->mark == sc->refs->stamp) return;
+    s->mark = sc->refs->stamp;
+
+    if(sc->out != NULL) memcpy(sc->out + sc->len, s->def, s->def_len);
+    sc->len += s->def_len;
+}
+
+/* --- Internal API --- */
+
+lv_markdown_refs_t * lv_markdown_refs_create(void)
+{
+    return (lv_markdown_refs_t *)lv_calloc(1, sizeof(lv_markdown_refs_t));
+}
+
+void lv_markdown_refs_delete(lv_markdown_refs_t * refs)
+{
+    if(refs == NULL) return;
+
+    for(uint32_t i = 0; i < refs->cap; i++) {
+        if(refs->slots[i].hash > REFS_TOMB) refs_free_slot(&refs->slots[i]);
+    }
+    lv_free(refs->slots);
+    lv_free(refs->defs);
+    lv_free(refs);
+}
+
+void lv_markdown_refs_scan(lv_markdown_refs_t * refs, uint32_t seq, uint32_t oldest,
+                           const char * src, uint32_t len)
+{
+    if(refs == NULL) return;
+
+    refs_scan_ctx_t sc = { refs, seq, oldest };
+    refs_walk(src, len, scan_def_cb, scan_ref_cb, &sc);
+    if(refs->cap > 0) refs_sweep(refs, oldest);
+}
+
+const char * lv_markdown_refs_source(lv_markdown_refs_t * refs, const char * src, uint32_t len,
+                                     uint32_t * out_len)
+{
+    *out_len = len;
+    if(refs == NULL || refs->used == 0) return src;
+
+    /* Measure the definitions this chunk needs, then copy them after it */
+    refs_source_ctx_t sc = { refs, NULL, 0 };
+    refs->stamp++;
+    refs_walk(src, len, NULL, source_ref_cb, &sc);
+    if(sc.len == 0) return src;
+
+    char * buf = (char *)lv_malloc((size_t)len + 2 + sc.len);
+    if(buf == NULL) return src;
+
+    memcpy(buf, src, len);
+    buf[len]     = '\n';
+    buf[len + 1] = '\n';
+
+    sc.out = buf + len + 2;
+    sc.len = 0;
+    refs->stamp++;
+    refs_walk(src, len, NULL, source_ref_cb, &sc);
+
+    *out_len = len + 2 + sc.len;
+    return buf;
+}
+
+void lv_markdown_refs_source_free(const char * src, const char * buf)
+{
+    if(buf != src) lv_free((void *)buf);
+}
+
+void lv_markdown_refs_take_changed(lv_markdown_refs_t * refs, uint32_t oldest,
+                                   void (*cb)(uint32_t seq, void * user_data), void * user_data)
+{
+    if(refs == NULL) return;
+
+    refs_trim_defs(refs, oldest);
+    if(refs->changed_cnt == 0) return;
+
+    for(uint32_t i = 0; i < refs->cap && refs->changed_cnt > 0; i++) {
+        refs_label_t * s = &refs->slots[i];
+        if(s->hash <= REFS_TOMB || !s->changed) continue;
+
+        s->changed = 0;
+        refs->changed_cnt--;
+        refs_compact(s, oldest);
+        for(uint32_t k = 0; k < s->seq_cnt; k++) cb(s->seqs[k], user_data);
+    }
+}
@@ -0,0 +1,163 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown_registry.h"
+#include "lv_markdown_private.h"
+#include <string.h>
+
+/* --- Registry --- */
+
+static lv_markdown_handler_entry_t handlers[LV_MARKDOWN_BLOCK_HANDLER_MAX];
+
+static int lang_equal(const char * a, const char * b)
+{
+    if(a == NULL || b == NULL) return a == b;
+    return strcmp(a, b) == 0;
+}
+
+lv_result_t lv_markdown_register_block_handler(lv_markdown_block_type_t type, const char * lang,
+                                               lv_markdown_block_handler_t handler, int32_t placeholder_h,
+                                               void * user_data)
+{
+    if(handler == NULL) return LV_RESULT_INVALID;
+
+    lv_markdown_handler_entry_t * free_slot = NULL;
+    for(int i = 0; i < LV_MARKDOWN_BLOCK_HANDLER_MAX; i++) {
+        lv_markdown_handler_entry_t * e = &handlers[i];
+        if(e->handler == NULL) {
+            if(free_slot == NULL) free_slot = e;
+            continue;
+        }
+        if(e->type == type && lang_equal(e->lang, lang)) {
+            free_slot = e;
+            break;
+        }
+    }
+    if(free_slot == NULL) return LV_RESULT_INVALID;
+
+    free_slot->type          = type;
+    free_slot->lang          = lang;
+    free_slot->handler       = handler;
+    free_slot->placeholder_h = placeholder_h;
+    free_slot->user_data     = user_data;
+    return LV_RESULT_OK;
+}
+
+void lv_markdown_unregister_block_handler(lv_markdown_block_type_t type, const char * lang)
+{
+    for(int i = 0; i < LV_MARKDOWN_BLOCK_HANDLER_MAX; i++) {
+        lv_markdown_handler_entry_t * e = &handlers[i];
+        if(e->handler != NULL && e->type == type && lang_equal(e->lang, lang)) {
+            memset(e, 0, sizeof(*e));
+        }
+    }
+}
+
+const lv_markdown_handler_entry_t * lv_markdown_find_block_handler(lv_markdown_block_type_t type,
+                                                                   const char * lang, uint32_t lang_len)
+{
+    const lv_markdown_handler_entry_t * any = NULL;
+
+    for(int i = 0; i < LV_MARKDOWN_BLOCK_HANDLER_MAX; i++) {
+        const lv_markdown_handler_entry_t * e = &handlers[i];
+        if(e->handler == NULL || e->type != type) continue;
+        if(e->lang == NULL) {
+            any = e;
+        }
+        else if(lang != NULL && strlen(e->lang) == lang_len && memcmp(e->lang, lang, lang_len) == 0) {
+            return e;
+        }
+    }
+    return any;
+}
+
+/* --- Lazy construction --- */
+
+/**
+ * A deferred block: the handler and a copy of the block model, kept in the
+ * placeholder's user data until it is first drawn.
+ */
+typedef struct {
+    lv_markdown_block_handler_t handler;
+    void *                      user_data;
+    const lv_markdown_style_t * style;
+    lv_markdown_block_type_t    type;
+    uint8_t                     scheduled;  /**< Build queued with lv_async_call */
+    uint32_t                    text_len;
+    char                        strings[];  /**< lang NUL text NUL */
+} lazy_block_t;
+
+static void lazy_build_async(void * p)
+{
+    lv_obj_t * placeholder = (lv_obj_t *)p;
+    lazy_block_t * lazy = (lazy_block_t *)lv_obj_get_user_data(placeholder);
+    if(lazy == NULL) return;
+
+    lv_obj_set_user_data(placeholder, NULL);
+
+    const char * lang = lazy->strings;
+    lv_markdown_block_t block = {
+        .type     = lazy->type,
+        .lang     = lang,
+        .text     = lang + strlen(lang) + 1,
+        .text_len = lazy->text_len,
+        .style    = lazy->style,
+    };
+    lazy->handler(placeholder, &block, lazy->user_data);
+    lv_free(lazy);
+
+    lv_obj_set_height(placeholder, LV_SIZE_CONTENT);
+}
+
+static void lazy_event_cb(lv_event_t * e)
+{
+    lv_obj_t * placeholder = lv_event_get_target(e);
+    lazy_block_t * lazy = (lazy_block_t *)lv_obj_get_user_data(placeholder);
+    if(lazy == NULL) return;
+
+    if(lv_event_get_code(e) == LV_EVENT_DELETE) {
+        if(lazy->scheduled) lv_async_call_cancel(lazy_build_async, placeholder);
+        lv_free(lazy);
+        lv_obj_set_user_data(placeholder, NULL);
+    }
+    else if(!lazy->scheduled) {
+        /* Being drawn means visible; don't change the tree mid-draw */
+        lazy->scheduled = 1;
+        lv_async_call(lazy_build_async, placeholder);
+    }
+}
+
+static lv_obj_t * create_placeholder(lv_obj_t * parent, const lv_markdown_handler_entry_t * h,
+                                     const lv_markdown_block_t * block)
+{
+    size_t lang_len = strlen(block->lang);
+    lazy_block_t * lazy = (lazy_block_t *)lv_malloc(sizeof(lazy_block_t) + lang_len + 1 + block->text_len + 1);
+    if(lazy == NULL) return NULL;
+
+    lazy->handler   = h->handler;
+    lazy->user_data = h->user_data;
+    lazy->style     = block->style;
+    lazy->type      = block->type;
+    lazy->scheduled = 0;
+    lazy->text_len  = block->text_len;
+    memcpy(lazy->strings, block->lang, lang_len + 1);
+    memcpy(lazy->strings + lang_len + 1, block->text, block->text_len);
+    lazy->strings[lang_len + 1 + block->text_len] = '\0';
+
+    lv_obj_t * placeholder = lv_obj_create(parent);
+    lv_obj_remove_style_all(placeholder);
+    lv_obj_set_width(placeholder, LV_PCT(100));
+    lv_obj_set_height(placeholder, h->placeholder_h);
+    lv_obj_set_user_data(placeholder, lazy);
+    lv_obj_add_event_cb(placeholder, lazy_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+    lv_obj_add_event_cb(placeholder, lazy_event_cb, LV_EVENT_DELETE, NULL);
+
+    return placeholder;
+}
+
+lv_obj_t * lv_markdown_run_block_handler(lv_obj_t * parent, const lv_markdown_handler_entry_t * h,
+                                         const lv_markdown_block_t * block)
+{
+    if(h->placeholder_h > 0) return create_placeholder(parent, h, block);
+
+    return h->handler(parent, block, h->user_data);
+}
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_registry.h
+ * @brief Application-provided renderers for individual block types
+ *
+ * By default every block is built by the renderer itself. A handler
+ * registered for a block type (or, for code blocks, a fence language)
+ * replaces that construction: it receives the parsed block and creates
+ * whatever objects it likes. Handlers registered with a placeholder
+ * height are lazy: an empty placeholder of that height is created instead,
+ * and the handler runs only once the placeholder is first drawn.
+ *
+ * Unregistered blocks are rendered as before.
+ */
+
+#ifndef LV_MARKDOWN_REGISTRY_H
+#define LV_MARKDOWN_REGISTRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+#include "lv_markdown_style.h"
+
+/** Maximum number of registered handlers */
+#ifndef LV_MARKDOWN_BLOCK_HANDLER_MAX
+#define LV_MARKDOWN_BLOCK_HANDLER_MAX 8
+#endif
+
+/** Block types that can be handed to a handler */
+typedef enum {
+    LV_MARKDOWN_BLOCK_HR = 0,   /**< Thematic break (---) */
+    LV_MARKDOWN_BLOCK_CODE,     /**< Fenced or indented code block */
+} lv_markdown_block_type_t;
+
+/** Parsed block passed to a handler */
+typedef struct {
+    lv_markdown_block_type_t    type;
+    const char *                lang;   /**< Fence language ("" if none), NUL-terminated */
+    const char *                text;   /**< Block content ("" for HR), NUL-terminated, no trailing newline */
+    uint32_t                    text_len;
+    const lv_markdown_style_t * style;  /**< Style the document is rendered with */
+} lv_markdown_block_t;
+
+/**
+ * Build a block.
+ * The block and its strings are only valid during the call.
+ *
+ * @param parent    object to create the block in (the document, a blockquote,
+ *                  or the placeholder of a lazy handler)
+ * @param block     the parsed block
+ * @param user_data user data given at registration
+ * @return          the created top object, which gets the usual block spacing,
+ *                  or NULL if nothing was created (e.g. merged into the previous block)
+ */
+typedef lv_obj_t * (*lv_markdown_block_handler_t)(lv_obj_t * parent, const lv_markdown_block_t * block,
+                                                  void * user_data);
+
+/**
+ * Register a handler for a block type, replacing any handler with the same key.
+ * Affects documents rendered afterwards.
+ *
+ * @param type              block type
+ * @param lang              fence language to match (code blocks only), or NULL for any;
+ *                          a language match wins over NULL. Not copied.
+ * @param handler           the handler
+ * @param placeholder_h     0 to build while parsing; >0 to create a placeholder of
+ *                          this height and build on first draw
+ * @param user_data         passed to the handler
+ * @return                  LV_RESULT_OK, or LV_RESULT_INVALID if the registry is full
+ */
+lv_result_t lv_markdown_register_block_handler(lv_markdown_block_type_t type, const char * lang,
+                                               lv_markdown_block_handler_t handler, int32_t placeholder_h,
+                                               void * user_data);
+
+/**
+ * Remove a handler registered with the same type and language.
+ *
+ * @param type      block type
+ * @param lang      fence language, or NULL
+ */
+void lv_markdown_unregister_block_handler(lv_markdown_block_type_t type, const char * lang);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_REGISTRY_H */
@@ -0,0 +1,221 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown_sched.h"
+#include "lv_markdown_private.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* Distance of widgets that can't be seen at all (hidden, other screen) */
+#define SCHED_DIST_OFFSCREEN INT32_MAX
+
+/* --- Internal data --- */
+
+static lv_obj_t ** sched_queue;     /**< Queued widgets, next to build last once sorted */
+static uint32_t    sched_cnt;
+static uint32_t    sched_cap;
+static uint32_t    sched_budget;    /**< ms per frame, 0 = off */
+static uint32_t    sched_order;     /**< Requests so far */
+static lv_timer_t * sched_timer;
+
+/* --- Priority --- */
+
+/**
+ * Check whether a widget is on its display's active screen or top layer.
+ */
+static bool sched_on_shown_screen(lv_obj_t * obj)
+{
+    lv_obj_t * screen = lv_obj_get_screen(obj);
+    lv_display_t * disp = lv_obj_get_display(obj);
+    return screen == lv_display_get_screen_active(disp) || screen == lv_display_get_layer_top(disp);
+}
+
+/**
+ * A widget waiting for content may have no height yet: use its top line.
+ */
+static void sched_top_area(lv_obj_t * obj, lv_area_t * a)
+{
+    lv_obj_get_coords(obj, a);
+    if(a->y2 < a->y1) a->y2 = a->y1;
+}
+
+/**
+ * Distance from a widget to what is shown: 0 if any part of it is visible,
+ * else the gap to its scrollable ancestor's viewport.
+ */
+static int32_t sched_distance(lv_obj_t * obj)
+{
+    if(!sched_on_shown_screen(obj)) return SCHED_DIST_OFFSCREEN;
+    if(lv_markdown_in_view(obj)) return 0;
+
+    lv_area_t a;
+    sched_top_area(obj, &a);
+
+    lv_obj_t * view = lv_obj_get_parent(obj);
+    while(view != NULL && !lv_obj_has_flag(view, LV_OBJ_FLAG_SCROLLABLE)) {
+        view = lv_obj_get_parent(view);
+    }
+    if(view == NULL) return SCHED_DIST_OFFSCREEN;
+
+    lv_area_t v;
+    lv_obj_get_coords(view, &v);
+    int32_t dy = a.y1 > v.y2 ? a.y1 - v.y2 : (a.y2 < v.y1 ? v.y1 - a.y2 : 0);
+    int32_t dx = a.x1 > v.x2 ? a.x1 - v.x2 : (a.x2 < v.x1 ? v.x1 - a.x2 : 0);
+
+    /* In the viewport but clipped further up, or hidden: still close */
+    return LV_MAX(1, dx + dy);
+}
+
+typedef struct {
+    lv_obj_t * obj;
+    int32_t    dist;
+    uint32_t   order;   /**< Requests queued before it */
+} sched_entry_t;
+
+/* Farthest first, later requests first among equals */
+static int sched_cmp(const void * a, const void * b)
+{
+    const sched_entry_t * ea = (const sched_entry_t *)a;
+    const sched_entry_t * eb = (const sched_entry_t *)b;
+    if(ea->dist != eb->dist) return ea->dist < eb->dist ? 1 : -1;
+    if(ea->order == eb->order) return 0;
+    return (int32_t)(ea->order - eb->order) < 0 ? 1 : -1;
+}
+
+/**
+ * Sort the queue so the widget to build next is last, measuring each
+ * distance once. Widgets queued while building are taken first.
+ */
+static void sched_sort(void)
+{
+    if(sched_cnt < 2) return;
+
+    /* Out of memory: keep the current order */
+    sched_entry_t * e = (sched_entry_t *)lv_malloc(sched_cnt * sizeof(sched_entry_t));
+    if(e == NULL) return;
+
+    for(uint32_t i = 0; i < sched_cnt; i++) {
+        e[i].obj   = sched_queue[i];
+        e[i].dist  = sched_distance(sched_queue[i]);
+        e[i].order = ((lv_markdown_data_t *)lv_obj_get_user_data(sched_queue[i]))->sched_order;
+    }
+    qsort(e, sched_cnt, sizeof(sched_entry_t), sched_cmp);
+    for(uint32_t i = 0; i < sched_cnt; i++) sched_queue[i] = e[i].obj;
+
+    lv_free(e);
+}
+
+static void sched_remove(uint32_t idx)
+{
+    memmove(&sched_queue[idx], &sched_queue[idx + 1], (sched_cnt - idx - 1) * sizeof(lv_obj_t *));
+    sched_cnt--;
+    if(sched_cnt == 0 && sched_timer != NULL) lv_timer_pause(sched_timer);
+}
+
+static void sched_timer_cb(lv_timer_t * t)
+{
+    (void)t;
+    lv_markdown_sched_run(sched_budget);
+}
+
+/* --- Internal API --- */
+
+bool lv_markdown_in_view(lv_obj_t * obj)
+{
+    if(!sched_on_shown_screen(obj) || lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
+
+    /* Clip by the parents only: LVGL also clips to the widget's own
+     * area, which is empty until it has content */
+    lv_area_t a;
+    sched_top_area(obj, &a);
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    return parent == NULL || lv_obj_area_is_visible(parent, &a);
+}
+
+bool lv_markdown_sched_defer(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(sched_budget == 0) return false;
+    if(data->sched_pending) return true;
+
+    if(sched_cnt == sched_cap) {
+        uint32_t new_cap = sched_cap ? sched_cap * 2 : 16;
+        lv_obj_t ** queue = (lv_obj_t **)lv_realloc(sched_queue, new_cap * sizeof(lv_obj_t *));
+        /* Out of memory: render right away */
+        if(queue == NULL) return false;
+        sched_queue = queue;
+        sched_cap   = new_cap;
+    }
+
+    sched_queue[sched_cnt++] = obj;
+    data->sched_pending = 1;
+    data->sched_order   = sched_order++;
+    lv_timer_resume(sched_timer);
+    return true;
+}
+
+void lv_markdown_sched_cancel(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(!data->sched_pending) return;
+
+    for(uint32_t i = 0; i < sched_cnt; i++) {
+        if(sched_queue[i] == obj) {
+            sched_remove(i);
+            break;
+        }
+    }
+    data->sched_pending = 0;
+}
+
+/* --- Public API --- */
+
+void lv_markdown_sched_enable(uint32_t budget_ms)
+{
+    if(budget_ms == 0) {
+        lv_markdown_sched_flush();
+        if(sched_timer != NULL) lv_timer_delete(sched_timer);
+        lv_free(sched_queue);
+        sched_timer  = NULL;
+        sched_queue  = NULL;
+        sched_cap    = 0;
+        sched_budget = 0;
+        return;
+    }
+
+    if(sched_timer == NULL) {
+        sched_timer = lv_timer_create(sched_timer_cb, LV_DEF_REFR_PERIOD, NULL);
+        if(sched_timer == NULL) return;
+        if(sched_cnt == 0) lv_timer_pause(sched_timer);
+    }
+    sched_budget = budget_ms;
+}
+
+uint32_t lv_markdown_sched_run(uint32_t budget_ms)
+{
+    uint32_t start = lv_tick_get();
+    uint32_t built = 0;
+
+    sched_sort();
+    while(sched_cnt > 0) {
+        uint32_t idx = sched_cnt - 1;
+        lv_obj_t * obj = sched_queue[idx];
+        lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+        sched_remove(idx);
+        data->sched_pending = 0;
+
+        lv_markdown_rebuild(obj, data);
+        built++;
+
+        if(lv_tick_elaps(start) >= budget_ms) break;
+    }
+    return built;
+}
+
+void lv_markdown_sched_flush(void)
+{
+    while(sched_cnt > 0) lv_markdown_sched_run(UINT32_MAX);
+}
+
+uint32_t lv_markdown_sched_get_pending(void)
+{
+    return sched_cnt;
+}
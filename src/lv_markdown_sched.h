@@ -0,0 +1,59 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_sched.h
+ * @brief Deferred, prioritized rendering across markdown widgets
+ *
+ * With the scheduler on, lv_markdown_set_text and restyles don't render
+ * right away. The widget is queued, and an LVGL timer builds queued widgets
+ * each frame within a time budget, nearest to the viewport first: visible
+ * widgets, then by distance from the scrolled view, then widgets on
+ * screens that aren't shown.
+ *
+ * Everything runs on the LVGL thread. A widget is one unit of work (parse
+ * and build are done in one pass), so a budget is exceeded by at most one
+ * widget.
+ */
+
+#ifndef LV_MARKDOWN_SCHED_H
+#define LV_MARKDOWN_SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+/**
+ * Turn the scheduler on or off. Turning it off builds every queued widget.
+ *
+ * @param budget_ms     building time per frame, 0 = off
+ */
+void lv_markdown_sched_enable(uint32_t budget_ms);
+
+/**
+ * Build queued widgets now, as the scheduler's timer does each frame.
+ * At least one widget is built if any is queued.
+ *
+ * @param budget_ms     keep building until this much time has passed
+ * @return              number of widgets built
+ */
+uint32_t lv_markdown_sched_run(uint32_t budget_ms);
+
+/**
+ * Build every queued widget now, e.g. before taking a screenshot.
+ */
+void lv_markdown_sched_flush(void);
+
+/**
+ * Get the number of widgets waiting to be built.
+ *
+ * @return              queued widgets
+ */
+uint32_t lv_markdown_sched_get_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_SCHED_H */
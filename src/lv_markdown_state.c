@@ -0,0 +1,227 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_state.c
+ * @brief Save and restore the view of a document for instant screen resume
+ *
+ * A saved state records which block is at the top of the view and every
+ * block's height at the widget's width. On restore, offscreen blocks are
+ * pinned to those heights so the scroll range is right without wrapping
+ * their text; only the blocks covering the view are laid out before the
+ * first frame. Pins are released as blocks scroll into view, and since the
+ * heights are exact this never moves the content.
+ */
+
+#include "lv_markdown.h"
+#include "lv_markdown_private.h"
+
+#include <string.h>
+
+/* Block whose height is pinned from a saved state */
+#define STATE_FLAG_PINNED LV_OBJ_FLAG_USER_2
+
+/* --- Helpers --- */
+
+static lv_obj_t * state_find_scroller(lv_obj_t * obj)
+{
+    lv_obj_t * scroller = lv_obj_get_parent(obj);
+    while(scroller != NULL && !lv_obj_has_flag(scroller, LV_OBJ_FLAG_SCROLLABLE)) {
+        scroller = lv_obj_get_parent(scroller);
+    }
+    return scroller;
+}
+
+/**
+ * Screen y where the scroller's content area starts.
+ */
+static int32_t state_view_top(lv_obj_t * scroller)
+{
+    lv_area_t a;
+    lv_obj_get_coords(scroller, &a);
+    return a.y1 + lv_obj_get_style_border_width(scroller, 0) + lv_obj_get_style_pad_top(scroller, 0);
+}
+
+static void state_unpin(lv_markdown_data_t * data, lv_obj_t * block)
+{
+    lv_obj_remove_flag(block, STATE_FLAG_PINNED);
+    lv_obj_set_height(block, LV_SIZE_CONTENT);
+    data->state_pinned_cnt--;
+}
+
+/**
+ * Release pinned blocks that scrolled into view.
+ */
+static void state_scroll_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = (lv_obj_t *)lv_event_get_user_data(e);
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->state_pinned_cnt == 0) return;
+
+    uint32_t cnt = lv_obj_get_child_count(obj);
+    for(uint32_t i = 0; i < cnt; i++) {
+        lv_obj_t * block = lv_obj_get_child(obj, (int32_t)i);
+        if(!lv_obj_has_flag(block, STATE_FLAG_PINNED)) continue;
+
+        lv_area_t area;
+        lv_obj_get_coords(block, &area);
+        if(lv_obj_area_is_visible(block, &area)) state_unpin(data, block);
+    }
+}
+
+/**
+ * Saved heights are only valid at the saved width: re-wrap everything
+ * if the widget is resized.
+ */
+static void state_size_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->state_pinned_cnt == 0) return;
+    if(lv_obj_get_width(obj) == data->state_width) return;
+
+    lv_markdown_state_reset(obj, data);
+}
+
+/* --- Internal API --- */
+
+void lv_markdown_state_reset(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(data->state_scroller == NULL) return;
+
+    lv_obj_remove_event_cb_with_user_data(data->state_scroller, state_scroll_cb, obj);
+    lv_obj_remove_event_cb(obj, state_size_cb);
+    data->state_scroller = NULL;
+
+    uint32_t cnt = lv_obj_get_child_count(obj);
+    for(uint32_t i = 0; i < cnt && data->state_pinned_cnt > 0; i++) {
+        lv_obj_t * block = lv_obj_get_child(obj, (int32_t)i);
+        if(lv_obj_has_flag(block, STATE_FLAG_PINNED)) state_unpin(data, block);
+    }
+    data->state_pinned_cnt = 0;
+}
+
+/* --- Public API --- */
+
+lv_result_t lv_markdown_save_state(lv_obj_t * obj, lv_markdown_state_t * state)
+{
+    lv_memzero(state, sizeof(lv_markdown_state_t));
+
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->text_ptr == NULL || data->log != NULL) return LV_RESULT_INVALID;
+
+    /* Build a waiting widget now: its blocks are what is being described */
+    lv_markdown_build_pending(obj, data);
+    lv_obj_update_layout(obj);
+
+    uint32_t cnt = lv_obj_get_child_count(obj);
+    if(cnt > 0) {
+        state->heights = (int32_t *)lv_malloc(cnt * sizeof(int32_t));
+        if(state->heights == NULL) return LV_RESULT_INVALID;
+    }
+
+    uint32_t len = (uint32_t)strlen(data->text_ptr);
+    state->doc_len   = len;
+    state->doc_hash  = lv_markdown_pack_hash(data->text_ptr, len);
+    state->width     = lv_obj_get_width(obj);
+    state->block_cnt = cnt;
+
+    lv_obj_t * scroller = state_find_scroller(obj);
+    int32_t view_top = scroller != NULL ? state_view_top(scroller) : 0;
+    bool anchored = scroller == NULL;
+
+    for(uint32_t i = 0; i < cnt; i++) {
+        lv_obj_t * block = lv_obj_get_child(obj, (int32_t)i);
+        state->heights[i] = lv_obj_get_height(block);
+
+        /* Anchor: the first block that reaches below the top of the view */
+        if(!anchored) {
+            lv_area_t a;
+            lv_obj_get_coords(block, &a);
+            if(a.y2 >= view_top) {
+                state->anchor_block  = i;
+                state->anchor_offset = view_top - a.y1;
+                anchored = true;
+            }
+        }
+    }
+    if(!anchored && cnt > 0) {
+        /* Scrolled past the end: keep the last block at the top */
+        state->anchor_block = cnt - 1;
+    }
+
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_markdown_restore_state(lv_obj_t * obj, const lv_markdown_state_t * state)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->text_ptr == NULL || data->log != NULL) return LV_RESULT_INVALID;
+
+    uint32_t len = (uint32_t)strlen(data->text_ptr);
+    if(len != state->doc_len || lv_markdown_pack_hash(data->text_ptr, len) != state->doc_hash) {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_markdown_build_pending(obj, data);
+    lv_markdown_state_reset(obj, data);
+
+    uint32_t cnt = lv_obj_get_child_count(obj);
+    if(cnt != state->block_cnt || state->anchor_block >= LV_MAX(cnt, 1)) return LV_RESULT_INVALID;
+
+    lv_obj_t * scroller = state_find_scroller(obj);
+    if(scroller == NULL || cnt == 0) return LV_RESULT_OK;
+
+    /* Pin every block first: the layout pass that sizes the widget then
+     * doesn't wrap any text */
+    if(state->heights != NULL) {
+        for(uint32_t i = 0; i < cnt; i++) {
+            lv_obj_t * block = lv_obj_get_child(obj, (int32_t)i);
+            if(lv_obj_get_style_height(block, 0) != LV_SIZE_CONTENT) continue;
+            lv_obj_add_flag(block, STATE_FLAG_PINNED);
+            lv_obj_set_height(block, state->heights[i]);
+            data->state_pinned_cnt++;
+        }
+        data->state_scroller = scroller;
+        lv_obj_update_layout(scroller);
+    }
+
+    if(lv_obj_get_width(obj) != state->width) {
+        /* Heights are for another width: lay out normally */
+        lv_markdown_state_reset(obj, data);
+    }
+    else {
+        /* Release the blocks covering the view */
+        int32_t view_h = lv_obj_get_content_height(scroller);
+        int32_t covered = -state->anchor_offset;
+        for(uint32_t i = state->anchor_block; i < cnt && covered < view_h; i++) {
+            lv_obj_t * block = lv_obj_get_child(obj, (int32_t)i);
+            if(lv_obj_has_flag(block, STATE_FLAG_PINNED)) state_unpin(data, block);
+            covered += state->heights[i];
+        }
+    }
+
+    /* Wraps only the unpinned blocks */
+    lv_obj_update_layout(scroller);
+
+    lv_area_t a;
+    lv_obj_get_coords(lv_obj_get_child(obj, (int32_t)state->anchor_block), &a);
+    int32_t y = a.y1 - state_view_top(scroller) + lv_obj_get_scroll_y(scroller) + state->anchor_offset;
+    lv_obj_scroll_to_y(scroller, y, LV_ANIM_OFF);
+
+    if(data->state_pinned_cnt > 0) {
+        lv_obj_add_event_cb(scroller, state_scroll_cb, LV_EVENT_SCROLL, obj);
+        lv_obj_add_event_cb(obj, state_size_cb, LV_EVENT_SIZE_CHANGED, NULL);
+        data->state_width = state->width;
+    }
+    else {
+        data->state_scroller = NULL;
+    }
+
+    return LV_RESULT_OK;
+}
+
+void lv_markdown_state_free(lv_markdown_state_t * state)
+{
+    lv_free(state->heights);
+    state->heights = NULL;
+}
@@ -37,6 +37,7 @@ void lv_markdown_style_init(lv_markdown_style_t * style)
 
     /* Blockquotes */
     style->blockquote_border_color = lv_color_make(200, 200, 200);
+    style->blockquote_border_opa   = LV_OPA_COVER;
     style->blockquote_border_width = 3;
     style->blockquote_pad_left     = 12;
 
@@ -49,4 +50,10 @@ void lv_markdown_style_init(lv_markdown_style_t * style)
     style->line_spacing      = 4;
     style->list_indent       = 20;
     style->list_bullet       = "\xe2\x80\xa2"; /* UTF-8 bullet: • */
+    style->task_unchecked    = "[ ]";
+    style->task_checked      = "[x]";
+
+    /* Low-cost draw profile emphasis colors */
+    style->faux_bold_color   = lv_color_make(26, 35, 126);  /* dark indigo */
+    style->faux_italic_color = lv_color_make(90, 90, 90);   /* dim gray */
 }
@@ -55,6 +55,7 @@ typedef struct {
 
     /* Blockquotes */
     lv_color_t         blockquote_border_color;
+    lv_opa_t           blockquote_border_opa;
     int32_t            blockquote_border_width;
     int32_t            blockquote_pad_left;
 
@@ -67,6 +68,12 @@ typedef struct {
     int32_t            line_spacing;         /**< Line spacing within a block */
     int32_t            list_indent;          /**< Indent per list nesting level */
     const char *       list_bullet;          /**< Bullet character (default: "•") */
+    const char *       task_unchecked;       /**< Prefix of open task items `- [ ]` (default: "[ ]") */
+    const char *       task_checked;         /**< Prefix of done task items `- [x]` (default: "[x]") */
+
+    /* Low-cost draw profile: emphasis fallbacks become a plain color change */
+    lv_color_t         faux_bold_color;      /**< Replaces letter-spaced faux bold */
+    lv_color_t         faux_italic_color;    /**< Replaces underline faux italic */
 } lv_markdown_style_t;
 
 /**
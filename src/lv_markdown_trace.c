@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: MIT */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "lv_markdown_trace.h"
+
+#if LV_MARKDOWN_USE_TRACE && defined(LV_MARKDOWN_TRACE_CHROME)
+
+#include <stdio.h>
+#include <time.h>
+
+static FILE *   trace_file;
+static uint32_t trace_events;
+
+lv_result_t lv_markdown_trace_chrome_open(const char * path)
+{
+    lv_markdown_trace_chrome_close();
+
+    trace_file = fopen(path, "w");
+    if(trace_file == NULL) return LV_RESULT_INVALID;
+
+    trace_events = 0;
+    fputs("[\n", trace_file);
+    return LV_RESULT_OK;
+}
+
+void lv_markdown_trace_chrome_close(void)
+{
+    if(trace_file == NULL) return;
+
+    fputs("\n]\n", trace_file);
+    fclose(trace_file);
+    trace_file = NULL;
+}
+
+void lv_markdown_trace_chrome_event(const char * name, char phase)
+{
+    if(trace_file == NULL) return;
+
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    double us = (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+
+    fprintf(trace_file, "%s{\"name\":\"%s\",\"cat\":\"lv_markdown\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":1}",
+            trace_events ? ",\n" : "", name, phase, us);
+    trace_events++;
+}
+
+#endif /* LV_MARKDOWN_USE_TRACE && LV_MARKDOWN_TRACE_CHROME */
@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_trace.h
+ * @brief Begin/end trace events at parse and build boundaries
+ *
+ * The renderer emits LV_MARKDOWN_TRACE_BEGIN/END pairs around md_parse,
+ * each enter/leave block callback ("enter p", "leave code", ...) and each
+ * span it creates. With
+ * LV_MARKDOWN_USE_TRACE 0 (the default) the macros compile to nothing.
+ *
+ * With LV_MARKDOWN_USE_TRACE 1 the events go to the built-in Chrome trace
+ * JSON writer (POSIX only, load the file in Perfetto or chrome://tracing).
+ * To use another tracer, e.g. SEGGER SystemView on an MCU, define both
+ * macros in lv_conf.h; `name` is always a string with static lifetime:
+ *
+ *   #define LV_MARKDOWN_TRACE_BEGIN(name) my_trace_begin(name)
+ *   #define LV_MARKDOWN_TRACE_END(name)   my_trace_end(name)
+ */
+
+#ifndef LV_MARKDOWN_TRACE_H
+#define LV_MARKDOWN_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+#ifndef LV_MARKDOWN_USE_TRACE
+#define LV_MARKDOWN_USE_TRACE 0
+#endif
+
+#if LV_MARKDOWN_USE_TRACE
+
+#ifndef LV_MARKDOWN_TRACE_BEGIN
+#define LV_MARKDOWN_TRACE_CHROME 1
+#define LV_MARKDOWN_TRACE_BEGIN(name) lv_markdown_trace_chrome_event(name, 'B')
+#define LV_MARKDOWN_TRACE_END(name)   lv_markdown_trace_chrome_event(name, 'E')
+#endif
+
+#else
+
+#define LV_MARKDOWN_TRACE_BEGIN(name) do {} while(0)
+#define LV_MARKDOWN_TRACE_END(name)   do {} while(0)
+
+#endif /* LV_MARKDOWN_USE_TRACE */
+
+#if LV_MARKDOWN_USE_TRACE && defined(LV_MARKDOWN_TRACE_CHROME)
+
+/**
+ * Start writing Chrome trace JSON to a file. Events before this are dropped.
+ *
+ * @param path      output file, overwritten
+ * @return          LV_RESULT_OK, or LV_RESULT_INVALID if it can't be opened
+ */
+lv_result_t lv_markdown_trace_chrome_open(const char * path);
+
+/**
+ * Finish the JSON array and close the file.
+ */
+void lv_markdown_trace_chrome_close(void);
+
+/**
+ * Write one event. Used by the trace macros.
+ *
+ * @param name      event name (static string)
+ * @param phase     'B' (begin) or 'E' (end)
+ */
+void lv_markdown_trace_chrome_event(const char * name, char phase);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_TRACE_H */
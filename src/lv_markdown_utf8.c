@@ -0,0 +1,163 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_utf8.c
+ * @brief UTF-8 validation and repair (see lv_markdown_utf8.h)
+ *
+ * Markdown is mostly ASCII, so the scan looks for the next byte >= 0x80 a
+ * vector at a time and only decodes the sequences it finds there, following
+ * the well-formed table of Unicode 3.9 (RFC 3629). Repair writes U+FFFD for
+ * each maximal invalid subpart, the substitution WHATWG and ICU use.
+ */
+
+#include "lv_markdown_utf8.h"
+
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/* --- ASCII runs --- */
+
+/**
+ * Number of leading ASCII bytes.
+ */
+static size_t utf8_ascii_run(const uint8_t * p, size_t len)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    while(i + 32 <= len) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(const void *)(p + i));
+        if(_mm256_movemask_epi8(v) != 0) break;
+        i += 32;
+    }
+#elif defined(__SSE2__)
+    while(i + 16 <= len) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(const void *)(p + i));
+        if(_mm_movemask_epi8(v) != 0) break;
+        i += 16;
+    }
+#elif defined(__ARM_NEON)
+    while(i + 16 <= len) {
+        uint8x16_t v = vld1q_u8(p + i);
+        uint8x8_t any = vorr_u8(vget_low_u8(v), vget_high_u8(v));
+        if(vget_lane_u64(vreinterpret_u64_u8(any), 0) & 0x8080808080808080ull) break;
+        i += 16;
+    }
+#endif
+
+    while(i + 8 <= len) {
+        uint64_t w;
+        memcpy(&w, p + i, 8);
+        if(w & 0x8080808080808080ull) break;
+        i += 8;
+    }
+    while(i < len && p[i] < 0x80) i++;
+    return i;
+}
+
+/* --- Multi-byte sequences --- */
+
+/**
+ * Length of the valid sequence at p (lead byte >= 0x80), or 0 with `bad`
+ * set to the length of the maximal invalid subpart.
+ */
+static uint32_t utf8_seq(const uint8_t * p, size_t avail, uint32_t * bad)
+{
+    uint8_t c = p[0];
+    uint8_t lo = 0x80;
+    uint8_t hi = 0xBF;
+    uint32_t n;
+
+    if(c >= 0xC2 && c <= 0xDF) {
+        n = 2;
+    }
+    else if(c >= 0xE0 && c <= 0xEF) {
+        n = 3;
+        if(c == 0xE0) lo = 0xA0;        /* overlong */
+        else if(c == 0xED) hi = 0x9F;   /* surrogates */
+    }
+    else if(c >= 0xF0 && c <= 0xF4) {
+        n = 4;
+        if(c == 0xF0) lo = 0x90;        /* overlong */
+        else if(c == 0xF4) hi = 0x8F;   /* above U+10FFFF */
+    }
+    else {
+        *bad = 1;
+        return 0;
+    }
+
+    /* Only the second byte has a narrowed range */
+    for(uint32_t k = 1; k < n; k++) {
+        if(k >= avail || p[k] < lo || p[k] > hi) {
+            *bad = k;
+            return 0;
+        }
+        lo = 0x80;
+        hi = 0xBF;
+    }
+    return n;
+}
+
+/* --- Public API --- */
+
+void lv_markdown_utf8_scan(const char * text, size_t len, lv_markdown_utf8_result_t * res)
+{
+    const uint8_t * p = (const uint8_t *)text;
+    size_t i = 0;
+
+    res->invalid = 0;
+    res->ascii   = true;
+
+    while(i < len) {
+        i += utf8_ascii_run(p + i, len - i);
+        if(i >= len) break;
+
+        res->ascii = false;
+        uint32_t bad;
+        uint32_t n = utf8_seq(p + i, len - i, &bad);
+        if(n == 0) {
+            res->invalid++;
+            n = bad;
+        }
+        i += n;
+    }
+}
+
+size_t lv_markdown_utf8_repair(const char * text, size_t len, char * out)
+{
+    const uint8_t * p = (const uint8_t *)text;
+    size_t i = 0;
+    size_t o = 0;
+
+    while(i < len) {
+        size_t run = utf8_ascii_run(p + i, len - i);
+        memcpy(out + o, text + i, run);
+        i += run;
+        o += run;
+        if(i >= len) break;
+
+        uint32_t bad;
+        uint32_t n = utf8_seq(p + i, len - i, &bad);
+        if(n == 0) {
+            out[o++] = (char)0xEF;
+            out[o++] = (char)0xBF;
+            out[o++] = (char)0xBD;
+            i += bad;
+        }
+        else {
+            memcpy(out + o, text + i, n);
+            i += n;
+            o += n;
+        }
+    }
+
+    out[o] = '\0';
+    return o;
+}
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file lv_markdown_utf8.h
+ * @brief UTF-8 validation and repair of markdown input
+ *
+ * lv_markdown_set_text and lv_markdown_set_text_static run every text
+ * through lv_markdown_utf8_scan (see lv_markdown_set_utf8_policy). Runs of
+ * ASCII are skipped a vector at a time (AVX2, SSE2 or NEON when the
+ * compiler targets them, 8 bytes at a time otherwise); only multi-byte
+ * sequences are decoded one by one.
+ */
+
+#ifndef LV_MARKDOWN_UTF8_H
+#define LV_MARKDOWN_UTF8_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+/** What the widget does with text that isn't valid UTF-8 */
+typedef enum {
+    LV_MARKDOWN_UTF8_REPAIR = 0,    /**< Replace invalid sequences with U+FFFD (default) */
+    LV_MARKDOWN_UTF8_CHECK,         /**< Only report it, see lv_markdown_get_utf8_valid */
+    LV_MARKDOWN_UTF8_OFF,           /**< Don't scan the text */
+} lv_markdown_utf8_policy_t;
+
+typedef struct {
+    size_t invalid;     /**< Invalid sequences (0 = valid UTF-8) */
+    bool   ascii;       /**< Only ASCII bytes */
+} lv_markdown_utf8_result_t;
+
+/**
+ * Validate UTF-8. Overlong forms, surrogates, code points above U+10FFFF
+ * and truncated sequences are invalid; each maximal invalid subpart counts
+ * once, as it would be replaced by lv_markdown_utf8_repair.
+ *
+ * @param text      text to check (need not be NUL-terminated)
+ * @param len       length of text in bytes
+ * @param res       receives the result
+ */
+void lv_markdown_utf8_scan(const char * text, size_t len, lv_markdown_utf8_result_t * res);
+
+/**
+ * Copy text, replacing each invalid sequence with U+FFFD, in one pass.
+ *
+ * @param text      text to repair
+ * @param len       length of text in bytes
+ * @param out       receives the repaired text and a NUL; must hold
+ *                  len + 2 * invalid + 1 bytes (invalid from lv_markdown_utf8_scan)
+ * @return          length of the repaired text
+ */
+size_t lv_markdown_utf8_repair(const char * text, size_t len, char * out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LV_MARKDOWN_UTF8_H */
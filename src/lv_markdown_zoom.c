@@ -0,0 +1,376 @@
+/* SPDX-License-Identifier: MIT */
+
+#include "lv_markdown.h"
+#include "lv_markdown_private.h"
+#include <string.h>
+
+/* Offscreen block whose height is pinned until it is re-wrapped */
+#define ZOOM_FLAG_PINNED LV_OBJ_FLAG_USER_1
+
+/* --- Font role mapping --- */
+
+lv_style_prop_t lv_markdown_font_role_prop(void)
+{
+    static lv_style_prop_t prop;
+    if(prop == 0) prop = lv_style_register_prop(LV_STYLE_PROP_FLAG_NONE);
+    return prop;
+}
+
+/**
+ * Font of a role in a style, with the same fallbacks the renderer uses.
+ * Emphasis roles without a font map to body_font.
+ */
+static const lv_font_t * zoom_role_font(const lv_markdown_style_t * s, int32_t role)
+{
+    const lv_font_t * font = NULL;
+
+    switch(role) {
+        case LV_MARKDOWN_FONT_BOLD:
+            font = s->bold_font;
+            break;
+        case LV_MARKDOWN_FONT_ITALIC:
+            font = s->italic_font;
+            break;
+        case LV_MARKDOWN_FONT_BOLD_ITALIC:
+            font = s->bold_italic_font;
+            break;
+        case LV_MARKDOWN_FONT_CODE:
+            font = s->code_font;
+            break;
+        default:
+            if(role >= LV_MARKDOWN_FONT_H1 && role < LV_MARKDOWN_FONT_H1 + 6) {
+                font = s->heading_font[role - LV_MARKDOWN_FONT_H1];
+            }
+            break;
+    }
+    return font ? font : s->body_font;
+}
+
+/**
+ * Swap fonts (and line spacing) of a block subtree in place, by the role
+ * the renderer recorded next to each font. Fonts without a role are kept.
+ */
+static void zoom_swap_fonts(lv_obj_t * obj, const lv_markdown_style_t * to)
+{
+    lv_style_prop_t role_prop = lv_markdown_font_role_prop();
+    lv_style_value_t v;
+
+    if(lv_obj_get_local_style_prop(obj, role_prop, &v, 0) == LV_STYLE_RES_FOUND) {
+        lv_obj_set_style_text_font(obj, zoom_role_font(to, v.num), 0);
+    }
+    if(lv_obj_get_local_style_prop(obj, LV_STYLE_TEXT_LINE_SPACE, &v, 0) == LV_STYLE_RES_FOUND) {
+        lv_obj_set_style_text_line_space(obj, to->line_spacing, 0);
+    }
+
+    if(lv_obj_check_type(obj, &lv_spangroup_class)) {
+        uint32_t span_cnt = lv_spangroup_get_span_count(obj);
+        for(uint32_t i = 0; i < span_cnt; i++) {
+            lv_style_t * style = lv_span_get_style(lv_spangroup_get_child(obj, (int32_t)i));
+            if(lv_style_get_prop(style, role_prop, &v) == LV_STYLE_RES_FOUND) {
+                lv_style_set_text_font(style, zoom_role_font(to, v.num));
+            }
+        }
+        lv_spangroup_refresh(obj);
+    }
+
+    uint32_t child_cnt = lv_obj_get_child_count(obj);
+    for(uint32_t i = 0; i < child_cnt; i++) {
+        zoom_swap_fonts(lv_obj_get_child(obj, (int32_t)i), to);
+    }
+}
+
+/* --- Block helpers --- */
+
+static bool zoom_block_is_visible(lv_obj_t * block)
+{
+    lv_area_t area;
+    lv_obj_get_coords(block, &area);
+    return lv_obj_area_is_visible(block, &area);
+}
+
+/**
+ * Bring one top-level block to the active level: swap its fonts if they
+ * are behind and release a pinned height so it wraps with the new fonts.
+ */
+static void zoom_apply_block(lv_markdown_data_t * data, lv_obj_t * block, uint32_t idx)
+{
+    uint32_t from_level = data->zoom_block_level[idx];
+    if(from_level != data->zoom_level) {
+        zoom_swap_fonts(block, &data->zoom_levels[data->zoom_level]);
+        data->zoom_block_level[idx] = (uint16_t)data->zoom_level;
+    }
+
+    if(lv_obj_has_flag(block, ZOOM_FLAG_PINNED)) {
+        lv_obj_remove_flag(block, ZOOM_FLAG_PINNED);
+        lv_obj_set_height(block, LV_SIZE_CONTENT);
+        if(data->zoom_pinned_cnt > 0) data->zoom_pinned_cnt--;
+    }
+}
+
+/**
+ * Forget the per-block bookkeeping. The block count then no longer matches
+ * the tree, so set_zoom falls back to a full re-render.
+ */
+static void zoom_drop_blocks(lv_markdown_data_t * data)
+{
+    lv_free(data->zoom_block_level);
+    lv_free(data->zoom_heights);
+    data->zoom_block_level = NULL;
+    data->zoom_heights     = NULL;
+    data->zoom_block_cnt   = 0;
+}
+
+/**
+ * Re-wrap pinned blocks that scrolled into view.
+ */
+static void zoom_scroll_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = (lv_obj_t *)lv_event_get_user_data(e);
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->zoom_pinned_cnt == 0) return;
+
+    uint32_t cnt = LV_MIN(lv_obj_get_child_count(obj), data->zoom_block_cnt);
+    for(uint32_t i = 0; i < cnt; i++) {
+        lv_obj_t * block = lv_obj_get_child(obj, (int32_t)i);
+        if(lv_obj_has_flag(block, ZOOM_FLAG_PINNED) && zoom_block_is_visible(block)) {
+            zoom_apply_block(data, block, i);
+        }
+    }
+}
+
+static void zoom_attach_scroll_handler(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent != NULL && !lv_obj_has_flag(parent, LV_OBJ_FLAG_SCROLLABLE)) {
+        parent = lv_obj_get_parent(parent);
+    }
+    if(parent == NULL || parent == data->zoom_scroll_parent) return;
+
+    if(data->zoom_scroll_parent != NULL) {
+        lv_obj_remove_event_cb_with_user_data(data->zoom_scroll_parent, zoom_scroll_cb, obj);
+    }
+    lv_obj_add_event_cb(parent, zoom_scroll_cb, LV_EVENT_SCROLL, obj);
+    data->zoom_scroll_parent = parent;
+}
+
+/* --- Internal API --- */
+
+void lv_markdown_zoom_tree_changed(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(data->zoom_levels == NULL) return;
+
+    /* Blocks that survived a partial rebuild may still be pinned at older
+     * fonts: bring them to the active level before forgetting their state */
+    uint32_t cnt = lv_obj_get_child_count(obj);
+    for(uint32_t i = 0; i < cnt && data->zoom_pinned_cnt > 0; i++) {
+        lv_obj_t * block = lv_obj_get_child(obj, (int32_t)i);
+        if(lv_obj_has_flag(block, ZOOM_FLAG_PINNED)) {
+            zoom_swap_fonts(block, &data->zoom_levels[data->zoom_level]);
+            lv_obj_remove_flag(block, ZOOM_FLAG_PINNED);
+            lv_obj_set_height(block, LV_SIZE_CONTENT);
+            data->zoom_pinned_cnt--;
+        }
+    }
+    data->zoom_pinned_cnt = 0;
+
+    if(cnt != data->zoom_block_cnt) {
+        zoom_drop_blocks(data);
+        if(cnt == 0) return;
+
+        data->zoom_block_level = (uint16_t *)lv_malloc(cnt * sizeof(uint16_t));
+        data->zoom_heights     = (int32_t *)lv_malloc((size_t)cnt * data->zoom_level_count * sizeof(int32_t));
+        if(data->zoom_block_level == NULL || data->zoom_heights == NULL) {
+            /* Without bookkeeping, set_zoom falls back to a full re-render */
+            zoom_drop_blocks(data);
+            return;
+        }
+        data->zoom_block_cnt = cnt;
+    }
+
+    for(uint32_t i = 0; i < cnt; i++) {
+        data->zoom_block_level[i] = (uint16_t)data->zoom_level;
+    }
+    for(uint32_t i = 0; i < cnt * data->zoom_level_count; i++) {
+        data->zoom_heights[i] = -1;
+    }
+}
+
+void lv_markdown_zoom_blocks_removed(lv_obj_t * obj, lv_markdown_data_t * data, uint32_t idx, uint32_t cnt)
+{
+    if(data->zoom_levels == NULL || cnt == 0) return;
+
+    for(uint32_t i = idx; i < idx + cnt; i++) {
+        if(lv_obj_has_flag(lv_obj_get_child(obj, (int32_t)i), ZOOM_FLAG_PINNED) && data->zoom_pinned_cnt > 0) {
+            data->zoom_pinned_cnt--;
+        }
+    }
+
+    if(data->zoom_block_cnt != lv_obj_get_child_count(obj) || idx + cnt > data->zoom_block_cnt) {
+        zoom_drop_blocks(data);
+        return;
+    }
+
+    uint32_t lc   = data->zoom_level_count;
+    uint32_t tail = data->zoom_block_cnt - idx - cnt;
+    memmove(&data->zoom_block_level[idx], &data->zoom_block_level[idx + cnt], tail * sizeof(uint16_t));
+    memmove(&data->zoom_heights[(size_t)idx * lc], &data->zoom_heights[(size_t)(idx + cnt) * lc],
+            (size_t)tail * lc * sizeof(int32_t));
+    data->zoom_block_cnt -= cnt;
+}
+
+void lv_markdown_zoom_blocks_added(lv_obj_t * obj, lv_markdown_data_t * data, uint32_t idx, uint32_t cnt)
+{
+    if(data->zoom_levels == NULL || cnt == 0) return;
+
+    uint32_t old_cnt = data->zoom_block_cnt;
+    if(old_cnt + cnt != lv_obj_get_child_count(obj) || idx > old_cnt) {
+        zoom_drop_blocks(data);
+        return;
+    }
+
+    uint32_t lc      = data->zoom_level_count;
+    uint32_t new_cnt = old_cnt + cnt;
+    uint16_t * levels = (uint16_t *)lv_realloc(data->zoom_block_level, new_cnt * sizeof(uint16_t));
+    if(levels == NULL) {
+        zoom_drop_blocks(data);
+        return;
+    }
+    data->zoom_block_level = levels;
+
+    int32_t * heights = (int32_t *)lv_realloc(data->zoom_heights, (size_t)new_cnt * lc * sizeof(int32_t));
+    if(heights == NULL) {
+        zoom_drop_blocks(data);
+        return;
+    }
+    data->zoom_heights = heights;
+
+    /* New blocks were rendered with the active style */
+    uint32_t tail = old_cnt - idx;
+    memmove(&levels[idx + cnt], &levels[idx], tail * sizeof(uint16_t));
+    memmove(&heights[(size_t)(idx + cnt) * lc], &heights[(size_t)idx * lc], (size_t)tail * lc * sizeof(int32_t));
+    for(uint32_t i = idx; i < idx + cnt; i++) {
+        levels[i] = (uint16_t)data->zoom_level;
+    }
+    for(size_t i = (size_t)idx * lc; i < (size_t)(idx + cnt) * lc; i++) {
+        heights[i] = -1;
+    }
+    data->zoom_block_cnt = new_cnt;
+}
+
+void lv_markdown_zoom_reset(lv_obj_t * obj, lv_markdown_data_t * data)
+{
+    if(data->zoom_scroll_parent != NULL) {
+        lv_obj_remove_event_cb_with_user_data(data->zoom_scroll_parent, zoom_scroll_cb, obj);
+        data->zoom_scroll_parent = NULL;
+    }
+
+    zoom_drop_blocks(data);
+    data->zoom_pinned_cnt  = 0;
+    data->zoom_levels      = NULL;
+    data->zoom_level_count = 0;
+    data->zoom_level       = 0;
+}
+
+/* --- Public API --- */
+
+void lv_markdown_set_zoom_levels(lv_obj_t * obj, const lv_markdown_style_t * levels, uint32_t count)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    lv_markdown_zoom_reset(obj, data);
+    lv_obj_set_style_transform_scale(obj, LV_SCALE_NONE, 0);
+    if(levels == NULL || count == 0 || count > UINT16_MAX) return;
+
+    data->zoom_levels      = levels;
+    data->zoom_level_count = count;
+    data->zoom_level       = 0;
+    memcpy(&data->style, &levels[0], sizeof(lv_markdown_style_t));
+
+    if(data->text_ptr != NULL || data->log != NULL || data->huge != NULL) {
+        lv_markdown_rerender(obj, data);
+    }
+    else {
+        lv_markdown_zoom_tree_changed(obj, data);
+    }
+}
+
+void lv_markdown_set_zoom(lv_obj_t * obj, uint32_t level)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL || data->zoom_levels == NULL || level >= data->zoom_level_count) return;
+
+    /* Gesture is over: drop the transform */
+    lv_obj_set_style_transform_scale(obj, LV_SCALE_NONE, 0);
+    if(level == data->zoom_level) return;
+
+    uint32_t old_level = data->zoom_level;
+    data->zoom_level = level;
+    memcpy(&data->style, &data->zoom_levels[level], sizeof(lv_markdown_style_t));
+
+    uint32_t cnt = lv_obj_get_child_count(obj);
+    if(cnt != data->zoom_block_cnt) {
+        /* Bookkeeping unavailable (allocation failed): rebuild */
+        lv_markdown_rerender(obj, data);
+        return;
+    }
+
+    /* Saved heights from a restored view don't hold at the new level */
+    lv_markdown_state_reset(obj, data);
+
+    /* Finish re-wraps from the previous step so coords and heights are current.
+     * Pinned blocks have fixed heights, so this only lays out visible ones. */
+    lv_obj_update_layout(obj);
+
+    int32_t old_lh = lv_font_get_line_height(data->zoom_levels[old_level].body_font);
+    int32_t new_lh = lv_font_get_line_height(data->zoom_levels[level].body_font);
+
+    for(uint32_t i = 0; i < cnt; i++) {
+        lv_obj_t * block = lv_obj_get_child(obj, (int32_t)i);
+        int32_t h = lv_obj_get_height(block);
+        int pinned = lv_obj_has_flag(block, ZOOM_FLAG_PINNED);
+
+        /* Remember the real height at the level this block is laid out at */
+        if(!pinned && data->zoom_block_level[i] == old_level) {
+            data->zoom_heights[i * data->zoom_level_count + old_level] = h;
+        }
+
+        /* Fixed-height blocks (e.g. rules) don't wrap, so swapping is cheap.
+         * A pinned block's fixed height is ours, not the renderer's */
+        if(zoom_block_is_visible(block) || (!pinned && lv_obj_get_style_height(block, 0) != LV_SIZE_CONTENT)) {
+            zoom_apply_block(data, block, i);
+            continue;
+        }
+
+        /* Offscreen: keep the old fonts, pin a cached or estimated height */
+        int32_t pin_h = data->zoom_heights[i * data->zoom_level_count + level];
+        if(pin_h < 0) {
+            pin_h = old_lh > 0 ? (int32_t)((int64_t)h * new_lh / old_lh) : h;
+        }
+        if(!pinned) {
+            lv_obj_add_flag(block, ZOOM_FLAG_PINNED);
+            data->zoom_pinned_cnt++;
+        }
+        lv_obj_set_height(block, pin_h);
+    }
+
+    if(data->zoom_pinned_cnt > 0) {
+        zoom_attach_scroll_handler(obj, data);
+    }
+}
+
+uint32_t lv_markdown_get_zoom(lv_obj_t * obj)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return 0;
+
+    return data->zoom_level;
+}
+
+void lv_markdown_set_zoom_scale(lv_obj_t * obj, int32_t scale)
+{
+    lv_markdown_data_t * data = (lv_markdown_data_t *)lv_obj_get_user_data(obj);
+    if(data == NULL) return;
+
+    lv_obj_set_style_transform_scale(obj, scale, 0);
+}
@@ -11,12 +11,19 @@
 /* Color depth: 32-bit for testing */
 #define LV_COLOR_DEPTH 32
 
-/* Use stdlib for memory, strings, etc. */
-#define LV_USE_STDLIB_MALLOC    LV_STDLIB_CLIB
+/* Allocator core from lv_markdown_alloc.c (clib + counting), stdlib for the rest */
+#define LV_USE_STDLIB_MALLOC    LV_STDLIB_CUSTOM
+#define LV_MARKDOWN_USE_ALLOC_STATS 1
 #define LV_USE_STDLIB_STRING    LV_STDLIB_CLIB
 #define LV_USE_STDLIB_SPRINTF   LV_STDLIB_CLIB
 
-/* Memory: use clib malloc */
+/* Trace events to the built-in Chrome JSON writer (POSIX) */
+#define LV_MARKDOWN_USE_TRACE   1
+
+/* Small huge-document sections, so tests reach the forced cut */
+#define LV_MARKDOWN_HUGE_SECTION_MAX 1024
+
+/* Memory: unused by the custom allocator core */
 #define LV_MEM_SIZE             (256 * 1024)
 
 /* Display defaults */
@@ -25,6 +32,18 @@
 /* No OS */
 #define LV_USE_OS   LV_OS_NONE
 
+/* Bidi text, for the RTL run cache */
+#define LV_USE_BIDI 1
+
+/* Offscreen rendering, for the batch renderer */
+#define LV_USE_SNAPSHOT 1
+
+/* stdio file system as "A:", for document packs */
+#define LV_USE_FS_STDIO         1
+#define LV_FS_STDIO_LETTER      'A'
+#define LV_FS_STDIO_PATH        ""
+#define LV_FS_STDIO_CACHE_SIZE  0
+
 /* Logging disabled for tests (reduces noise) */
 #define LV_USE_LOG 0
 
@@ -43,7 +62,7 @@
 #define LV_USE_CHART        0
 #define LV_USE_CHECKBOX     0
 #define LV_USE_DROPDOWN     0
-#define LV_USE_IMAGE        0
+#define LV_USE_IMAGE        1   /* Pre-rendered documents */
 #define LV_USE_IMAGEBUTTON  0
 #define LV_USE_KEYBOARD     0
 #define LV_USE_LED          0
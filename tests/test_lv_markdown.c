@@ -10,10 +10,14 @@
 #include "lvgl.h"
 #include "lvgl_private.h"
 #include "lv_markdown.h"
+#include "lv_markdown_private.h"
 
 #include "unity/unity.h"
 
 #include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
 
 /* Forward declarations for test runner */
 void setUp(void);
@@ -1385,12 +1389,2294 @@ void test_markdown_set_text_static_null_clears(void)
     TEST_ASSERT_NULL(lv_markdown_get_text(md));
 }
 
+/* ===== Draw Profile Tests ===== */
+
+void test_markdown_draw_profile_default(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    TEST_ASSERT_EQUAL(LV_MARKDOWN_DRAW_PROFILE_DEFAULT, lv_markdown_get_draw_profile(md));
+}
+
+void test_markdown_low_cost_italic_uses_color(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_draw_profile(md, LV_MARKDOWN_DRAW_PROFILE_LOW_COST);
+    lv_markdown_set_text(md, "*italic*");
+
+    lv_obj_t * sg = lv_obj_get_child(md, 0);
+    lv_span_t * span = lv_spangroup_get_child(sg, 0);
+    TEST_ASSERT_NOT_NULL(span);
+
+    /* No underline, color change instead */
+    lv_style_value_t val;
+    TEST_ASSERT_NOT_EQUAL(LV_STYLE_RES_FOUND, get_span_style_prop(span, LV_STYLE_TEXT_DECOR, &val));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, get_span_style_prop(span, LV_STYLE_TEXT_COLOR, &val));
+}
+
+void test_markdown_low_cost_bold_uses_color(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_draw_profile(md, LV_MARKDOWN_DRAW_PROFILE_LOW_COST);
+    lv_markdown_set_text(md, "***both***");
+
+    lv_obj_t * sg = lv_obj_get_child(md, 0);
+    lv_span_t * span = lv_spangroup_get_child(sg, 0);
+    TEST_ASSERT_NOT_NULL(span);
+
+    lv_style_value_t val;
+    TEST_ASSERT_NOT_EQUAL(LV_STYLE_RES_FOUND, get_span_style_prop(span, LV_STYLE_TEXT_LETTER_SPACE, &val));
+    TEST_ASSERT_NOT_EQUAL(LV_STYLE_RES_FOUND, get_span_style_prop(span, LV_STYLE_TEXT_DECOR, &val));
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, get_span_style_prop(span, LV_STYLE_TEXT_COLOR, &val));
+}
+
+void test_markdown_low_cost_square_code_block(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "```\ncode\n```");
+
+    lv_obj_t * container = lv_obj_get_child(md, 0);
+    TEST_ASSERT_EQUAL_INT32(4, lv_obj_get_style_radius(container, 0));
+
+    /* Switching profile re-renders with square corners */
+    lv_markdown_set_draw_profile(md, LV_MARKDOWN_DRAW_PROFILE_LOW_COST);
+    container = lv_obj_get_child(md, 0);
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_style_radius(container, 0));
+}
+
+void test_markdown_low_cost_solid_blockquote_border(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    style.blockquote_border_opa = LV_OPA_50;
+    lv_markdown_set_style(md, &style);
+
+    lv_markdown_set_text(md, "> quote");
+    TEST_ASSERT_EQUAL_UINT8(LV_OPA_50, lv_obj_get_style_border_opa(lv_obj_get_child(md, 0), 0));
+
+    lv_markdown_set_draw_profile(md, LV_MARKDOWN_DRAW_PROFILE_LOW_COST);
+    TEST_ASSERT_EQUAL_UINT8(LV_OPA_COVER, lv_obj_get_style_border_opa(lv_obj_get_child(md, 0), 0));
+}
+
+/* ===== Compact Message Tests ===== */
+
+void test_markdown_msg_plain_text_is_single_label(void)
+{
+    lv_obj_t * msg = lv_markdown_msg_create(lv_screen_active());
+    lv_markdown_msg_set_text(msg, "See you at 5");
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(msg));
+    lv_obj_t * label = lv_obj_get_child(msg, 0);
+    /* Static text: the label points at the message's own copy */
+    TEST_ASSERT_EQUAL_PTR(lv_markdown_msg_get_text(msg), lv_label_get_text(label));
+    TEST_ASSERT_EQUAL_STRING("See you at 5", lv_label_get_text(label));
+}
+
+void test_markdown_msg_formatted_text_renders_blocks(void)
+{
+    lv_obj_t * msg = lv_markdown_msg_create(lv_screen_active());
+    lv_markdown_msg_set_text(msg, "plain **bold** plain");
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(msg));
+    lv_obj_t * sg = lv_obj_get_child(msg, 0);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_spangroup_get_span_count(sg));
+}
+
+void test_markdown_msg_multi_block(void)
+{
+    lv_obj_t * msg = lv_markdown_msg_create(lv_screen_active());
+    lv_markdown_msg_set_text(msg, "# Title\n\n- one\n- two");
+
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(msg));
+}
+
+void test_markdown_msg_uses_shared_style(void)
+{
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    style.body_color = lv_color_make(0, 0, 255);
+    lv_markdown_msg_set_shared_style(&style);
+
+    lv_obj_t * msg = lv_markdown_msg_create(lv_screen_active());
+    lv_markdown_msg_set_text(msg, "Hello");
+
+    lv_color_t color = lv_obj_get_style_text_color(lv_obj_get_child(msg, 0), 0);
+    TEST_ASSERT_EQUAL_UINT32(255, color.blue);
+
+    lv_markdown_msg_set_shared_style(NULL);
+}
+
+void test_markdown_msg_data_size_is_small(void)
+{
+    lv_obj_t * msg = lv_markdown_msg_create(lv_screen_active());
+    TEST_ASSERT_EQUAL_UINT32(0, lv_markdown_msg_get_data_size(msg));
+
+    lv_markdown_msg_set_text(msg, "ok");
+    /* Header + "ok" + NUL, no style copy */
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(8, lv_markdown_msg_get_data_size(msg));
+}
+
+void test_markdown_msg_set_text_null_clears(void)
+{
+    lv_obj_t * msg = lv_markdown_msg_create(lv_screen_active());
+    lv_markdown_msg_set_text(msg, "Hello");
+    lv_markdown_msg_set_text(msg, NULL);
+
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(msg));
+    TEST_ASSERT_NULL(lv_markdown_msg_get_text(msg));
+}
+
+/* ===== Zoom Tests ===== */
+
+/* Distinct font pointers with real metrics, standing in for other sizes */
+static lv_font_t zoom_body_font;
+static lv_font_t zoom_h1_font;
+
+static void zoom_make_levels(lv_markdown_style_t levels[2])
+{
+    memcpy(&zoom_body_font, LV_FONT_DEFAULT, sizeof(lv_font_t));
+    memcpy(&zoom_h1_font, LV_FONT_DEFAULT, sizeof(lv_font_t));
+
+    lv_markdown_style_init(&levels[0]);
+    levels[0].heading_font[0] = LV_FONT_DEFAULT;
+
+    lv_markdown_style_init(&levels[1]);
+    levels[1].body_font       = &zoom_body_font;
+    levels[1].heading_font[0] = &zoom_h1_font;
+    levels[1].line_spacing    = 8;
+}
+
+void test_markdown_zoom_swaps_fonts_in_place(void)
+{
+    static lv_markdown_style_t levels[2];
+    zoom_make_levels(levels);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "# Title\n\nBody text");
+    lv_markdown_set_zoom_levels(md, levels, 2);
+
+    lv_obj_t * h1 = lv_obj_get_child(md, 0);
+    lv_obj_t * body = lv_obj_get_child(md, 1);
+
+    lv_markdown_set_zoom(md, 1);
+
+    /* Same objects, new fonts: no rebuild */
+    TEST_ASSERT_EQUAL_UINT32(1, lv_markdown_get_zoom(md));
+    TEST_ASSERT_EQUAL_PTR(h1, lv_obj_get_child(md, 0));
+    TEST_ASSERT_EQUAL_PTR(body, lv_obj_get_child(md, 1));
+    TEST_ASSERT_EQUAL_PTR(&zoom_h1_font, lv_obj_get_style_text_font(h1, 0));
+    TEST_ASSERT_EQUAL_PTR(&zoom_body_font, lv_obj_get_style_text_font(body, 0));
+    TEST_ASSERT_EQUAL_INT32(8, lv_obj_get_style_text_line_space(body, 0));
+
+    /* And back */
+    lv_markdown_set_zoom(md, 0);
+    TEST_ASSERT_EQUAL_PTR(LV_FONT_DEFAULT, lv_obj_get_style_text_font(body, 0));
+}
+
+void test_markdown_zoom_maps_span_fonts(void)
+{
+    static lv_markdown_style_t levels[2];
+    zoom_make_levels(levels);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_zoom_levels(md, levels, 2);
+    lv_markdown_set_text(md, "plain `code`");
+
+    lv_markdown_set_zoom(md, 1);
+
+    /* Inline code falls back to body_font, so it follows the body mapping */
+    lv_obj_t * sg = lv_obj_get_child(md, 0);
+    lv_span_t * code = lv_spangroup_get_child(sg, 1);
+    lv_style_value_t val;
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND, get_span_style_prop(code, LV_STYLE_TEXT_FONT, &val));
+    TEST_ASSERT_EQUAL_PTR(&zoom_body_font, val.ptr);
+}
+
+void test_markdown_zoom_defers_offscreen_blocks(void)
+{
+    static lv_markdown_style_t levels[2];
+    zoom_make_levels(levels);
+
+    /* Short scrollable viewport, long document */
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 400, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    lv_markdown_set_zoom_levels(md, levels, 2);
+
+    char buf[1024];
+    int pos = 0;
+    for(int i = 0; i < 40; i++) {
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "Para %d\n\n", i);
+    }
+    lv_markdown_set_text(md, buf);
+    lv_obj_update_layout(md);
+
+    lv_markdown_set_zoom(md, 1);
+
+    /* Visible block re-wrapped, last block kept its fonts and got a pinned height */
+    lv_obj_t * first = lv_obj_get_child(md, 0);
+    lv_obj_t * last = lv_obj_get_child(md, 39);
+    TEST_ASSERT_EQUAL_PTR(&zoom_body_font, lv_obj_get_style_text_font(first, 0));
+    TEST_ASSERT_EQUAL_PTR(LV_FONT_DEFAULT, lv_obj_get_style_text_font(last, 0));
+    TEST_ASSERT_NOT_EQUAL(LV_SIZE_CONTENT, lv_obj_get_style_height(last, 0));
+
+    /* Scrolling it into view re-wraps it */
+    lv_obj_scroll_to_y(view, LV_COORD_MAX, LV_ANIM_OFF);
+    lv_obj_update_layout(md);
+    lv_obj_scroll_to_y(view, LV_COORD_MAX, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_PTR(&zoom_body_font, lv_obj_get_style_text_font(last, 0));
+    TEST_ASSERT_EQUAL(LV_SIZE_CONTENT, lv_obj_get_style_height(last, 0));
+}
+
+void test_markdown_zoom_keeps_pinned_blocks_pinned(void)
+{
+    static lv_markdown_style_t levels[3];
+    zoom_make_levels(levels);
+    levels[2] = levels[1];
+    levels[2].line_spacing = 12;
+
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 400, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    lv_markdown_set_zoom_levels(md, levels, 3);
+
+    char buf[1024];
+    int pos = 0;
+    for(int i = 0; i < 40; i++) {
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "Para %d\n\n", i);
+    }
+    lv_markdown_set_text(md, buf);
+    lv_obj_update_layout(md);
+
+    /* A second step leaves the pinned block offscreen and unwrapped */
+    lv_markdown_set_zoom(md, 1);
+    lv_markdown_set_zoom(md, 2);
+    lv_obj_t * last = lv_obj_get_child(md, 39);
+    TEST_ASSERT_EQUAL_PTR(LV_FONT_DEFAULT, lv_obj_get_style_text_font(last, 0));
+    TEST_ASSERT_NOT_EQUAL(LV_SIZE_CONTENT, lv_obj_get_style_height(last, 0));
+    TEST_ASSERT_EQUAL_INT32(levels[0].line_spacing, lv_obj_get_style_text_line_space(last, 0));
+
+    lv_obj_delete(view);
+}
+
+void test_markdown_zoom_follows_log_trims(void)
+{
+    static lv_markdown_style_t levels[2];
+    zoom_make_levels(levels);
+
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 400, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    lv_markdown_set_log_mode(md, 40, 0);
+    lv_markdown_set_zoom_levels(md, levels, 2);
+
+    char line[16];
+    for(int i = 0; i < 40; i++) {
+        snprintf(line, sizeof(line), "Para %d\n\n", i);
+        lv_markdown_append(md, line);
+    }
+    lv_obj_update_layout(md);
+    lv_markdown_set_zoom(md, 1);
+
+    /* Trimming the head shifts the pinned tail block down by one */
+    lv_obj_t * pinned = lv_obj_get_child(md, 39);
+    lv_markdown_append(md, "Para 40\n\n");
+    TEST_ASSERT_EQUAL_PTR(pinned, lv_obj_get_child(md, 38));
+    TEST_ASSERT_EQUAL_PTR(LV_FONT_DEFAULT, lv_obj_get_style_text_font(pinned, 0));
+    TEST_ASSERT_NOT_EQUAL(LV_SIZE_CONTENT, lv_obj_get_style_height(pinned, 0));
+
+    /* The new block is at the active level, the pinned one still re-wraps */
+    lv_obj_t * added = lv_obj_get_child(md, 39);
+    TEST_ASSERT_EQUAL_PTR(&zoom_body_font, lv_obj_get_style_text_font(added, 0));
+    lv_obj_scroll_to_y(view, LV_COORD_MAX, LV_ANIM_OFF);
+    lv_obj_update_layout(md);
+    lv_obj_scroll_to_y(view, LV_COORD_MAX, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_PTR(&zoom_body_font, lv_obj_get_style_text_font(pinned, 0));
+    TEST_ASSERT_EQUAL(LV_SIZE_CONTENT, lv_obj_get_style_height(pinned, 0));
+
+    lv_obj_delete(view);
+}
+
+void test_markdown_zoom_scale_sets_transform(void)
+{
+    static lv_markdown_style_t levels[2];
+    zoom_make_levels(levels);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_zoom_levels(md, levels, 2);
+    lv_markdown_set_text(md, "Hello");
+
+    lv_markdown_set_zoom_scale(md, 384);
+    TEST_ASSERT_EQUAL_INT32(384, lv_obj_get_style_transform_scale_x(md, 0));
+
+    /* Settling ends the transform */
+    lv_markdown_set_zoom(md, 1);
+    TEST_ASSERT_EQUAL_INT32(LV_SCALE_NONE, lv_obj_get_style_transform_scale_x(md, 0));
+}
+
+void test_markdown_set_style_turns_zoom_off(void)
+{
+    static lv_markdown_style_t levels[2];
+    zoom_make_levels(levels);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_zoom_levels(md, levels, 2);
+    lv_markdown_set_text(md, "Hello");
+    lv_markdown_set_zoom(md, 1);
+
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    lv_markdown_set_style(md, &style);
+
+    TEST_ASSERT_EQUAL_UINT32(0, lv_markdown_get_zoom(md));
+    /* set_zoom is a no-op without levels */
+    lv_markdown_set_zoom(md, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_markdown_get_zoom(md));
+}
+
+/* ===== Bidi Cache Tests ===== */
+
+#if LV_USE_BIDI
+
+/* "שלום abc" in logical order */
+static const char bidi_run[] = "\xd7\xa9\xd7\x9c\xd7\x95\xd7\x9d abc";
+
+void test_markdown_bidi_cache_reuses_runs(void)
+{
+    lv_markdown_bidi_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    uint32_t len = (uint32_t)strlen(bidi_run);
+
+    const char * a = lv_markdown_bidi_cache_get(&cache, bidi_run, len, LV_BASE_DIR_RTL);
+    const char * b = lv_markdown_bidi_cache_get(&cache, bidi_run, len, LV_BASE_DIR_RTL);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_PTR(a, b);
+    TEST_ASSERT_EQUAL_UINT32(1, cache.misses);
+    TEST_ASSERT_EQUAL_UINT32(1, cache.hits);
+
+    /* Same result LVGL would compute on every draw */
+    char expected[sizeof(bidi_run)] = {0};
+    lv_bidi_process_paragraph(bidi_run, expected, len, LV_BASE_DIR_RTL, NULL, 0);
+    TEST_ASSERT_EQUAL_MEMORY(expected, a, len);
+
+    lv_markdown_bidi_cache_clear(&cache);
+    TEST_ASSERT_EQUAL_UINT32(0, cache.used);
+}
+
+void test_markdown_bidi_cache_keys_on_direction(void)
+{
+    lv_markdown_bidi_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    uint32_t len = (uint32_t)strlen(bidi_run);
+
+    const char * rtl = lv_markdown_bidi_cache_get(&cache, bidi_run, len, LV_BASE_DIR_RTL);
+    const char * ltr = lv_markdown_bidi_cache_get(&cache, bidi_run, len, LV_BASE_DIR_LTR);
+    TEST_ASSERT_NOT_EQUAL(rtl, ltr);
+    TEST_ASSERT_EQUAL_UINT32(2, cache.misses);
+
+    /* A prefix of the run is a different key */
+    lv_markdown_bidi_cache_get(&cache, bidi_run, len - 1, LV_BASE_DIR_RTL);
+    TEST_ASSERT_EQUAL_UINT32(3, cache.misses);
+
+    lv_markdown_bidi_cache_clear(&cache);
+}
+
+void test_markdown_bidi_hook_only_on_non_ascii_blocks(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    char buf[64];
+    snprintf(buf, sizeof(buf), "Hello\n\n%s", bidi_run);
+    lv_markdown_set_text(md, buf);
+
+    TEST_ASSERT_FALSE(lv_obj_has_flag(lv_obj_get_child(md, 0), LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS));
+    TEST_ASSERT_TRUE(lv_obj_has_flag(lv_obj_get_child(md, 1), LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS));
+
+    lv_markdown_set_bidi_cache(md, false);
+    TEST_ASSERT_FALSE(lv_obj_has_flag(lv_obj_get_child(md, 1), LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS));
+}
+
+void test_markdown_bidi_cache_survives_relayout(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, bidi_run);
+    lv_markdown_data_t * data = lv_obj_get_user_data(md);
+
+    lv_refr_now(NULL);
+    uint32_t misses = data->bidi_cache.misses;
+    TEST_ASSERT_TRUE(misses > 0);
+
+    /* Redraw and re-render with the same text: served from the cache */
+    lv_obj_invalidate(md);
+    lv_refr_now(NULL);
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    lv_markdown_set_style(md, &style);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(misses, data->bidi_cache.misses);
+
+    /* New text empties it */
+    lv_markdown_set_text(md, "other");
+    TEST_ASSERT_EQUAL_UINT32(0, data->bidi_cache.used);
+}
+
+void test_markdown_bidi_cache_flushes_when_full(void)
+{
+    /* The widget hooks its display, which counts frames */
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_bidi_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    char run[sizeof(bidi_run) + 8];
+
+    for(uint32_t i = 0; i < LV_MARKDOWN_BIDI_CACHE_MAX; i++) {
+        snprintf(run, sizeof(run), "%s%u", bidi_run, (unsigned)i);
+        TEST_ASSERT_NOT_NULL(lv_markdown_bidi_cache_get(&cache, run, (uint32_t)strlen(run), LV_BASE_DIR_RTL));
+    }
+
+    /* Full: refused for the rest of the frame, cached runs still served */
+    snprintf(run, sizeof(run), "%s+", bidi_run);
+    TEST_ASSERT_NULL(lv_markdown_bidi_cache_get(&cache, run, (uint32_t)strlen(run), LV_BASE_DIR_RTL));
+    snprintf(run, sizeof(run), "%s0", bidi_run);
+    TEST_ASSERT_NOT_NULL(lv_markdown_bidi_cache_get(&cache, run, (uint32_t)strlen(run), LV_BASE_DIR_RTL));
+
+    /* Emptied at the next frame */
+    lv_obj_invalidate(md);
+    lv_refr_now(NULL);
+    snprintf(run, sizeof(run), "%s+", bidi_run);
+    TEST_ASSERT_NOT_NULL(lv_markdown_bidi_cache_get(&cache, run, (uint32_t)strlen(run), LV_BASE_DIR_RTL));
+    TEST_ASSERT_EQUAL_UINT32(1, cache.used);
+
+    lv_markdown_bidi_cache_clear(&cache);
+    lv_obj_delete(md);
+}
+
+void test_markdown_bidi_cache_flushes_on_width_change(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, bidi_run);
+    lv_markdown_data_t * data = lv_obj_get_user_data(md);
+
+    lv_refr_now(NULL);
+    uint32_t misses = data->bidi_cache.misses;
+
+    /* Lines wrap anew: the runs are processed again */
+    lv_obj_set_width(md, 100);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(data->bidi_cache.misses > misses);
+
+    lv_obj_delete(md);
+}
+
+#endif /* LV_USE_BIDI */
+
+/* ===== Batch Renderer Tests ===== */
+
+#if LV_USE_SNAPSHOT
+
+/* Count pixels that are clearly darker than the white page */
+static uint32_t batch_dark_pixels(const lv_draw_buf_t * buf)
+{
+    uint32_t cnt = 0;
+    for(uint32_t y = 0; y < buf->header.h; y++) {
+        const uint8_t * row = buf->data + y * buf->header.stride;
+        for(uint32_t x = 0; x < buf->header.w; x++) {
+            if(row[x * 4] < 0x80 && row[x * 4 + 1] < 0x80 && row[x * 4 + 2] < 0x80) cnt++;
+        }
+    }
+    return cnt;
+}
+
+void test_markdown_batch_renders_into_one_buffer(void)
+{
+    lv_markdown_batch_t * batch = lv_markdown_batch_create(NULL, 200, 100, LV_COLOR_FORMAT_XRGB8888);
+    TEST_ASSERT_NOT_NULL(batch);
+
+    const lv_draw_buf_t * a = lv_markdown_batch_render(batch, "# Title\n\nSome text");
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_UINT32(200, a->header.w);
+    TEST_ASSERT_EQUAL_UINT32(100, a->header.h);
+    TEST_ASSERT_TRUE(batch_dark_pixels(a) > 0);
+
+    /* Next document overwrites the same buffer */
+    const lv_draw_buf_t * b = lv_markdown_batch_render(batch, "");
+    TEST_ASSERT_EQUAL_PTR(a, b);
+    TEST_ASSERT_EQUAL_UINT32(0, batch_dark_pixels(b));
+
+    lv_markdown_batch_delete(batch);
+}
+
+void test_markdown_batch_renders_with_scheduler_on(void)
+{
+    lv_markdown_sched_enable(5);
+    lv_markdown_batch_t * batch = lv_markdown_batch_create(NULL, 200, 100, LV_COLOR_FORMAT_XRGB8888);
+
+    /* Built before the snapshot, not at a later tick */
+    const lv_draw_buf_t * buf = lv_markdown_batch_render(batch, "# Title\n\nSome text");
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_TRUE(batch_dark_pixels(buf) > 0);
+
+    lv_markdown_batch_delete(batch);
+    lv_markdown_sched_enable(0);
+}
+
+static void batch_count_cb(uint32_t index, const lv_draw_buf_t * buf, void * user_data)
+{
+    uint32_t * seen = (uint32_t *)user_data;
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_EQUAL_UINT32(*seen, index);
+    (*seen)++;
+}
+
+void test_markdown_batch_render_list(void)
+{
+    static const char * const docs[] = { "one", "**two**", "- three\n- four" };
+    lv_markdown_batch_t * batch = lv_markdown_batch_create(NULL, 160, 120, LV_COLOR_FORMAT_XRGB8888);
+
+    uint32_t seen = 0;
+    TEST_ASSERT_EQUAL_UINT32(3, lv_markdown_batch_render_list(batch, docs, 3, batch_count_cb, &seen));
+    TEST_ASSERT_EQUAL_UINT32(3, seen);
+
+    lv_markdown_batch_stats_t stats;
+    lv_markdown_batch_get_stats(batch, &stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.docs);
+
+    lv_markdown_batch_reset_stats(batch);
+    lv_markdown_batch_get_stats(batch, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.docs);
+
+    lv_markdown_batch_delete(batch);
+}
+
+void test_markdown_batch_does_not_touch_active_screen(void)
+{
+    uint32_t before = lv_obj_get_child_count(lv_screen_active());
+
+    lv_markdown_batch_t * batch = lv_markdown_batch_create(NULL, 100, 50, LV_COLOR_FORMAT_XRGB8888);
+    lv_markdown_batch_render(batch, "Hello");
+    TEST_ASSERT_EQUAL_UINT32(before, lv_obj_get_child_count(lv_screen_active()));
+
+    lv_markdown_batch_delete(batch);
+}
+
+#endif /* LV_USE_SNAPSHOT */
+
+/* ===== Pre-rendered Document Tests ===== */
+
+#if LV_USE_IMAGE
+
+/* Two 4x2 ARGB8888 "blocks", as md_prerender -B would emit them */
+static const uint8_t prerender_px[4 * 2 * 4];
+
+static const lv_image_dsc_t prerender_img = {
+    .header.magic = LV_IMAGE_HEADER_MAGIC,
+    .header.cf = LV_COLOR_FORMAT_ARGB8888,
+    .header.w = 4,
+    .header.h = 2,
+    .header.stride = 16,
+    .data_size = sizeof(prerender_px),
+    .data = prerender_px,
+};
+
+static const lv_markdown_prerendered_block_t prerender_blocks[] = {
+    { 0, 0, &prerender_img },
+    { 0, 10, &prerender_img },
+};
+
+static const lv_markdown_prerendered_t prerender_doc = { 40, 12, 2, prerender_blocks };
+
+void test_markdown_prerendered_places_blocks(void)
+{
+    lv_obj_t * obj = lv_markdown_prerendered_create(lv_screen_active(), &prerender_doc);
+    lv_obj_update_layout(obj);
+
+    TEST_ASSERT_EQUAL_INT32(40, lv_obj_get_width(obj));
+    TEST_ASSERT_EQUAL_INT32(12, lv_obj_get_height(obj));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(obj));
+
+    lv_obj_t * second = lv_obj_get_child(obj, 1);
+    TEST_ASSERT_EQUAL_PTR(&prerender_img, lv_image_get_src(second));
+    TEST_ASSERT_EQUAL_INT32(10, lv_obj_get_y(second));
+    TEST_ASSERT_EQUAL_INT32(4, lv_obj_get_width(second));
+}
+
+void test_markdown_prerendered_null_doc_is_empty(void)
+{
+    lv_obj_t * obj = lv_markdown_prerendered_create(lv_screen_active(), NULL);
+    TEST_ASSERT_NOT_NULL(obj);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(obj));
+}
+
+#endif /* LV_USE_IMAGE */
+
+/* ===== Block Handler Registry Tests ===== */
+
+static char handler_seen_lang[64];
+static char handler_seen_text[64];
+static uint32_t handler_calls;
+
+static lv_obj_t * test_code_handler(lv_obj_t * parent, const lv_markdown_block_t * block, void * user_data)
+{
+    (void)user_data;
+    handler_calls++;
+    snprintf(handler_seen_lang, sizeof(handler_seen_lang), "%s", block->lang);
+    snprintf(handler_seen_text, sizeof(handler_seen_text), "%s", block->text);
+
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, LV_PCT(100), 30);
+    return obj;
+}
+
+/* Draw the rule as the previous block's bottom border instead of an object */
+static lv_obj_t * test_hr_handler(lv_obj_t * parent, const lv_markdown_block_t * block, void * user_data)
+{
+    (void)user_data;
+    lv_obj_t * prev = lv_obj_get_child(parent, -1);
+    if(prev != NULL) {
+        lv_obj_set_style_border_side(prev, LV_BORDER_SIDE_BOTTOM, 0);
+        lv_obj_set_style_border_width(prev, block->style->hr_height, 0);
+    }
+    return NULL;
+}
+
+void test_markdown_handler_by_fence_language(void)
+{
+    handler_calls = 0;
+    lv_markdown_register_block_handler(LV_MARKDOWN_BLOCK_CODE, "chart", test_code_handler, 0, NULL);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "```chart\n1 2 3\n```\n\n```c\nint x;\n```");
+
+    TEST_ASSERT_EQUAL_UINT32(1, handler_calls);
+    TEST_ASSERT_EQUAL_STRING("chart", handler_seen_lang);
+    TEST_ASSERT_EQUAL_STRING("1 2 3", handler_seen_text);
+
+    /* Handler object first, default code block (container + label) second */
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(lv_obj_get_child(md, 0)));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(lv_obj_get_child(md, 1)));
+    /* Default paragraph_spacing is 10 */
+    TEST_ASSERT_EQUAL_INT32(10, lv_obj_get_style_margin_top(lv_obj_get_child(md, 1), 0));
+
+    lv_markdown_unregister_block_handler(LV_MARKDOWN_BLOCK_CODE, "chart");
+}
+
+void test_markdown_handler_long_and_missing_language(void)
+{
+    static const char long_lang[] = "a-language-name-longer-than-32-bytes";
+
+    /* A long fence language reaches the handler whole */
+    handler_calls = 0;
+    lv_markdown_register_block_handler(LV_MARKDOWN_BLOCK_CODE, long_lang, test_code_handler, 0, NULL);
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    char buf[128];
+    snprintf(buf, sizeof(buf), "```%s\nx\n```", long_lang);
+    lv_markdown_set_text(md, buf);
+    TEST_ASSERT_EQUAL_UINT32(1, handler_calls);
+    TEST_ASSERT_EQUAL_STRING(long_lang, handler_seen_lang);
+    lv_markdown_unregister_block_handler(LV_MARKDOWN_BLOCK_CODE, long_lang);
+
+    /* Indented code has no language */
+    lv_markdown_register_block_handler(LV_MARKDOWN_BLOCK_CODE, NULL, test_code_handler, 0, NULL);
+    lv_markdown_set_text(md, "    indented");
+    TEST_ASSERT_EQUAL_UINT32(2, handler_calls);
+    TEST_ASSERT_EQUAL_STRING("", handler_seen_lang);
+    TEST_ASSERT_EQUAL_STRING("indented", handler_seen_text);
+    lv_markdown_unregister_block_handler(LV_MARKDOWN_BLOCK_CODE, NULL);
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_handler_hr_merged_into_previous(void)
+{
+    lv_markdown_register_block_handler(LV_MARKDOWN_BLOCK_HR, NULL, test_hr_handler, 0, NULL);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "above\n\n---\n\nbelow");
+
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL(LV_BORDER_SIDE_BOTTOM, lv_obj_get_style_border_side(lv_obj_get_child(md, 0), 0));
+
+    lv_markdown_unregister_block_handler(LV_MARKDOWN_BLOCK_HR, NULL);
+
+    /* Back to the built-in rule */
+    lv_markdown_set_text(md, "above\n\n---\n\nbelow");
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(md));
+}
+
+void test_markdown_handler_lazy_builds_on_draw(void)
+{
+    handler_calls = 0;
+    lv_markdown_register_block_handler(LV_MARKDOWN_BLOCK_CODE, NULL, test_code_handler, 40, NULL);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "```\nlazy\n```");
+
+    /* Placeholder only */
+    lv_obj_t * ph = lv_obj_get_child(md, 0);
+    lv_obj_update_layout(md);
+    TEST_ASSERT_EQUAL_UINT32(0, handler_calls);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(ph));
+    TEST_ASSERT_EQUAL_INT32(40, lv_obj_get_height(ph));
+
+    /* First draw schedules the build, the next timer run performs it */
+    lv_refr_now(NULL);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(1, handler_calls);
+    TEST_ASSERT_EQUAL_STRING("lazy", handler_seen_text);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(ph));
+
+    lv_markdown_unregister_block_handler(LV_MARKDOWN_BLOCK_CODE, NULL);
+}
+
+void test_markdown_handler_lazy_deleted_before_build(void)
+{
+    handler_calls = 0;
+    lv_markdown_register_block_handler(LV_MARKDOWN_BLOCK_CODE, NULL, test_code_handler, 40, NULL);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "```\nlazy\n```");
+    lv_refr_now(NULL);
+
+    /* Replacing the text deletes the placeholder with its build still queued */
+    lv_markdown_set_text(md, "plain");
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, handler_calls);
+
+    lv_markdown_unregister_block_handler(LV_MARKDOWN_BLOCK_CODE, NULL);
+}
+
+/* ===== Allocation Budget Tests ===== */
+
+#if LV_MARKDOWN_USE_ALLOC_STATS
+
+/* Budgets for re-rendering a 3-paragraph document. Raise only with a reason. */
+#define BUDGET_3P_BUILD_ALLOCS  60
+#define BUDGET_3P_PARSE_ALLOCS  32
+
+static const char * alloc_doc_3p =
+    "First paragraph with **bold**.\n\n"
+    "Second paragraph with *italic*.\n\n"
+    "Third paragraph, plain.";
+
+void test_markdown_alloc_rerender_within_budget(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, alloc_doc_3p);
+
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+
+    lv_markdown_alloc_stats_reset();
+    lv_markdown_set_style(md, &style);   /* clear + parse + build */
+
+    lv_markdown_alloc_stats_t build, parse, clear;
+    lv_markdown_alloc_stats_get(LV_MARKDOWN_PHASE_BUILD, &build);
+    lv_markdown_alloc_stats_get(LV_MARKDOWN_PHASE_PARSE, &parse);
+    lv_markdown_alloc_stats_get(LV_MARKDOWN_PHASE_CLEAR, &clear);
+
+    TEST_ASSERT_LESS_THAN_UINT32(BUDGET_3P_BUILD_ALLOCS, build.allocs);
+    TEST_ASSERT_LESS_THAN_UINT32(BUDGET_3P_PARSE_ALLOCS, parse.allocs);
+    TEST_ASSERT_TRUE(build.allocs > 0);
+    TEST_ASSERT_TRUE(clear.frees > 0);
+
+    /* md4c releases everything it allocated before md_parse returns */
+    TEST_ASSERT_EQUAL_UINT32(parse.allocs, parse.frees);
+}
+
+void test_markdown_alloc_rerender_not_costlier_than_render(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+    lv_markdown_alloc_stats_reset();
+    lv_markdown_set_text(md, alloc_doc_3p);
+    lv_markdown_alloc_stats_t first;
+    lv_markdown_alloc_stats_get(LV_MARKDOWN_PHASE_BUILD, &first);
+
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    lv_markdown_alloc_stats_reset();
+    lv_markdown_set_style(md, &style);
+    lv_markdown_alloc_stats_t again;
+    lv_markdown_alloc_stats_get(LV_MARKDOWN_PHASE_BUILD, &again);
+
+    TEST_ASSERT_TRUE(again.allocs <= first.allocs);
+}
+
+void test_markdown_alloc_no_leak_across_updates(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+    /* Warm up once so one-time allocations are excluded */
+    lv_markdown_set_text(md, alloc_doc_3p);
+    lv_markdown_set_text(md, NULL);
+    size_t live = lv_markdown_alloc_live_bytes();
+
+    lv_markdown_set_text(md, alloc_doc_3p);
+    lv_markdown_set_text(md, "# Other\n\n```\ncode\n```");
+    lv_markdown_set_text(md, NULL);
+    TEST_ASSERT_EQUAL_UINT32(live, lv_markdown_alloc_live_bytes());
+}
+
+void test_markdown_alloc_plain_msg_skips_parser(void)
+{
+    lv_obj_t * msg = lv_markdown_msg_create(lv_screen_active());
+
+    lv_markdown_alloc_stats_reset();
+    lv_markdown_msg_set_text(msg, "See you at 5");
+
+    lv_markdown_alloc_stats_t parse;
+    lv_markdown_alloc_stats_get(LV_MARKDOWN_PHASE_PARSE, &parse);
+    TEST_ASSERT_EQUAL_UINT32(0, parse.allocs);
+}
+
+#endif /* LV_MARKDOWN_USE_ALLOC_STATS */
+
+#if LV_MARKDOWN_USE_TRACE && defined(LV_MARKDOWN_TRACE_CHROME)
+
+static uint32_t count_substr(const char * s, const char * sub)
+{
+    uint32_t n = 0;
+    size_t len = strlen(sub);
+    for(const char * p = strstr(s, sub); p != NULL; p = strstr(p + len, sub)) n++;
+    return n;
+}
+
+void test_markdown_trace_writes_balanced_chrome_json(void)
+{
+    const char * path = "trace_test.json";
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_trace_chrome_open(path));
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "# Title\n\nSome **bold** text.\n\n```\ncode\n```");
+    lv_markdown_trace_chrome_close();
+
+    FILE * f = fopen(path, "rb");
+    TEST_ASSERT_NOT_NULL(f);
+    static char buf[16384];
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    buf[n] = '\0';
+    fclose(f);
+    remove(path);
+
+    TEST_ASSERT_EQUAL_INT('[', buf[0]);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "]\n"));
+    TEST_ASSERT_EQUAL_UINT32(1, count_substr(buf, "\"name\":\"md_parse\",\"cat\":\"lv_markdown\",\"ph\":\"B\""));
+    TEST_ASSERT_EQUAL_UINT32(4, count_substr(buf, "\"name\":\"span\",\"cat\":\"lv_markdown\",\"ph\":\"B\""));
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"name\":\"enter code\""));
+
+    /* Every begin has its end */
+    TEST_ASSERT_EQUAL_UINT32(count_substr(buf, "\"ph\":\"B\""), count_substr(buf, "\"ph\":\"E\""));
+}
+
+void test_markdown_trace_closed_writer_drops_events(void)
+{
+    lv_markdown_trace_chrome_close();   /* no-op when not open */
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "Nothing is recorded.");
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_markdown_trace_chrome_open("/nonexistent-dir/trace.json"));
+    lv_markdown_set_text(md, "Still nothing.");
+    lv_markdown_trace_chrome_close();
+}
+
+#endif /* LV_MARKDOWN_USE_TRACE && LV_MARKDOWN_TRACE_CHROME */
+
+/* ===== Task List / Strikethrough Tests ===== */
+
+void test_markdown_tasklist_glyph_prefix(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "- [ ] open\n- [x] done\n- plain");
+
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(md));
+
+    /* Glyph replaces the bullet; the item text follows in the same spangroup */
+    lv_obj_t * sg0 = lv_obj_get_child(md, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_spangroup_get_span_count(sg0));
+    TEST_ASSERT_EQUAL_STRING("[ ] ", lv_span_get_text(lv_spangroup_get_child(sg0, 0)));
+    TEST_ASSERT_EQUAL_STRING("open", lv_span_get_text(lv_spangroup_get_child(sg0, 1)));
+
+    lv_obj_t * sg1 = lv_obj_get_child(md, 1);
+    TEST_ASSERT_EQUAL_STRING("[x] ", lv_span_get_text(lv_spangroup_get_child(sg1, 0)));
+
+    /* Non-task items keep the bullet */
+    lv_obj_t * sg2 = lv_obj_get_child(md, 2);
+    TEST_ASSERT_NOT_NULL(strstr(lv_span_get_text(lv_spangroup_get_child(sg2, 0)), "\xe2\x80\xa2"));
+}
+
+void test_markdown_tasklist_custom_glyph_loose_list(void)
+{
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    style.task_checked = LV_SYMBOL_OK;
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_style(md, &style);
+    lv_markdown_set_text(md, "- [X] done\n\n- [ ] open");
+
+    lv_obj_t * sg0 = lv_obj_get_child(md, 0);
+    TEST_ASSERT_EQUAL_STRING(LV_SYMBOL_OK " ", lv_span_get_text(lv_spangroup_get_child(sg0, 0)));
+    lv_obj_t * sg1 = lv_obj_get_child(md, 1);
+    TEST_ASSERT_EQUAL_STRING("[ ] ", lv_span_get_text(lv_spangroup_get_child(sg1, 0)));
+}
+
+void test_markdown_tasklist_costs_no_more_objects_than_list(void)
+{
+    enum { ITEMS = 500 };
+    static char tasks[ITEMS * 16];
+    static char plain[ITEMS * 16];
+    size_t tl = 0;
+    size_t pl = 0;
+    for(int i = 0; i < ITEMS; i++) {
+        tl += (size_t)snprintf(tasks + tl, sizeof(tasks) - tl, "- [%c] item %d\n", (i % 3) ? ' ' : 'x', i);
+        pl += (size_t)snprintf(plain + pl, sizeof(plain) - pl, "- item %d\n", i);
+    }
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text_static(md, plain);
+    uint32_t plain_objs = lv_obj_get_child_count(md);
+    uint32_t plain_spans = lv_spangroup_get_span_count(lv_obj_get_child(md, 0));
+
+    lv_markdown_set_text_static(md, tasks);
+    TEST_ASSERT_EQUAL_UINT32(ITEMS, plain_objs);
+    TEST_ASSERT_EQUAL_UINT32(plain_objs, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_UINT32(plain_spans, lv_spangroup_get_span_count(lv_obj_get_child(md, 0)));
+    for(uint32_t i = 0; i < ITEMS; i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(lv_obj_get_child(md, (int32_t)i)));
+    }
+}
+
+void test_markdown_strikethrough_decor(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "~~gone~~ *~~both~~* kept");
+
+    lv_obj_t * sg = lv_obj_get_child(md, 0);
+    TEST_ASSERT_EQUAL_UINT32(4, lv_spangroup_get_span_count(sg));
+
+    lv_style_value_t val;
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND,
+                      get_span_style_prop(lv_spangroup_get_child(sg, 0), LV_STYLE_TEXT_DECOR, &val));
+    TEST_ASSERT_EQUAL_INT32(LV_TEXT_DECOR_STRIKETHROUGH, val.num);
+
+    /* Faux italic underline and strikethrough share the one decor property */
+    TEST_ASSERT_EQUAL(LV_STYLE_RES_FOUND,
+                      get_span_style_prop(lv_spangroup_get_child(sg, 2), LV_STYLE_TEXT_DECOR, &val));
+    TEST_ASSERT_EQUAL_INT32(LV_TEXT_DECOR_UNDERLINE | LV_TEXT_DECOR_STRIKETHROUGH, val.num);
+
+    TEST_ASSERT_NOT_EQUAL(LV_STYLE_RES_FOUND,
+                          get_span_style_prop(lv_spangroup_get_child(sg, 3), LV_STYLE_TEXT_DECOR, &val));
+}
+
+/* ===== Document Pack Tests ===== */
+
+static const char * pack_ids[] = { "home", "about", "faq" };
+static const char * pack_docs[] = { "# Help\n\nStart here.", "About **this** device", "- one\n- two" };
+
+static void pack_wr32(uint8_t * p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * Build a pack of pack_docs, laid out like tools/md_pack does.
+ */
+static uint32_t make_pack(uint8_t * buf, uint32_t cap)
+{
+    enum { CNT = 3 };
+    uint32_t order[CNT] = { 0, 1, 2 };
+
+    /* Index sorted by id hash */
+    for(uint32_t i = 0; i < CNT; i++) {
+        for(uint32_t j = i + 1; j < CNT; j++) {
+            if(lv_markdown_pack_hash(pack_ids[order[j]], strlen(pack_ids[order[j]])) <
+               lv_markdown_pack_hash(pack_ids[order[i]], strlen(pack_ids[order[i]]))) {
+                uint32_t t = order[i];
+                order[i] = order[j];
+                order[j] = t;
+            }
+        }
+    }
+
+    uint32_t names_size = 0;
+    for(uint32_t i = 0; i < CNT; i++) names_size += (uint32_t)strlen(pack_ids[i]) + 1;
+    uint32_t names_off = LV_MARKDOWN_PACK_HEADER_SIZE + CNT * LV_MARKDOWN_PACK_ENTRY_SIZE;
+
+    memset(buf, 0, cap);
+    memcpy(buf, LV_MARKDOWN_PACK_MAGIC, 4);
+    buf[4] = LV_MARKDOWN_PACK_VERSION;
+    buf[6] = LV_MARKDOWN_PACK_ENTRY_SIZE;
+    pack_wr32(buf + 8, CNT);
+    pack_wr32(buf + 12, names_size);
+
+    uint32_t id_off = 0;
+    uint32_t doc_off = names_off + names_size;
+    for(uint32_t i = 0; i < CNT; i++) {
+        const char * id = pack_ids[order[i]];
+        const char * doc = pack_docs[order[i]];
+        uint32_t id_len = (uint32_t)strlen(id);
+        uint32_t doc_len = (uint32_t)strlen(doc);
+        TEST_ASSERT_TRUE(doc_off + doc_len + 1 <= cap);
+
+        uint8_t * e = buf + LV_MARKDOWN_PACK_HEADER_SIZE + i * LV_MARKDOWN_PACK_ENTRY_SIZE;
+        pack_wr32(e + 0, lv_markdown_pack_hash(id, id_len));
+        pack_wr32(e + 4, id_off);
+        e[8] = (uint8_t)id_len;
+        e[10] = LV_MARKDOWN_PACK_FORMAT_TEXT;
+        pack_wr32(e + 12, doc_off);
+        pack_wr32(e + 16, doc_len);
+        pack_wr32(e + 20, lv_markdown_pack_hash(doc, doc_len));
+
+        memcpy(buf + names_off + id_off, id, id_len + 1);
+        memcpy(buf + doc_off, doc, doc_len + 1);
+        id_off += id_len + 1;
+        doc_off += doc_len + 1;
+    }
+    return doc_off;
+}
+
+void test_markdown_pack_array_loads_in_place(void)
+{
+    static uint8_t buf[512];
+    uint32_t size = make_pack(buf, sizeof(buf));
+
+    lv_markdown_pack_t * pack = lv_markdown_pack_open_array(buf, size);
+    TEST_ASSERT_NOT_NULL(pack);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_markdown_pack_get_count(pack));
+    TEST_ASSERT_EQUAL_INT32(-1, lv_markdown_pack_find(pack, "missing"));
+
+    for(uint32_t i = 0; i < 3; i++) {
+        int32_t idx = lv_markdown_pack_find(pack, pack_ids[i]);
+        TEST_ASSERT_TRUE(idx >= 0);
+        TEST_ASSERT_EQUAL_STRING(pack_ids[i], lv_markdown_pack_get_id(pack, (uint32_t)idx));
+
+        uint32_t len = 0;
+        const char * text = lv_markdown_pack_load(pack, (uint32_t)idx, &len);
+        TEST_ASSERT_EQUAL_STRING(pack_docs[i], text);
+        TEST_ASSERT_EQUAL_UINT32(strlen(pack_docs[i]), len);
+        TEST_ASSERT_EQUAL_UINT32(lv_markdown_pack_hash(text, len), lv_markdown_pack_get_hash(pack, (uint32_t)idx));
+
+        /* No copy: the text lives in the array */
+        TEST_ASSERT_TRUE((const uint8_t *)text > buf && (const uint8_t *)text < buf + size);
+        lv_markdown_pack_unload(pack, text);
+    }
+
+    lv_markdown_pack_close(pack);
+}
+
+void test_markdown_pack_rejects_malformed(void)
+{
+    static uint8_t buf[512];
+    uint32_t size = make_pack(buf, sizeof(buf));
+
+    /* Truncated: the last document runs past the end */
+    TEST_ASSERT_NULL(lv_markdown_pack_open_array(buf, size - 1));
+
+    /* Missing NUL after a document */
+    buf[size - 1] = 'x';
+    TEST_ASSERT_NULL(lv_markdown_pack_open_array(buf, size));
+    buf[size - 1] = '\0';
+
+    buf[0] = 'X';
+    TEST_ASSERT_NULL(lv_markdown_pack_open_array(buf, size));
+    TEST_ASSERT_NULL(lv_markdown_pack_open_array(buf, 4));
+}
+
+void test_markdown_pack_array_sets_text_static(void)
+{
+    static uint8_t buf[512];
+    uint32_t size = make_pack(buf, sizeof(buf));
+    lv_markdown_pack_t * pack = lv_markdown_pack_open_array(buf, size);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_set_text_from_pack(md, pack, "faq"));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_PTR(lv_markdown_pack_load(pack, (uint32_t)lv_markdown_pack_find(pack, "faq"), NULL),
+                          lv_markdown_get_text(md));
+
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_markdown_set_text_from_pack(md, pack, "nope"));
+
+    lv_obj_delete(md);
+    lv_markdown_pack_close(pack);
+}
+
+#if LV_USE_FS_STDIO
+void test_markdown_pack_file_loads_on_demand(void)
+{
+    static uint8_t buf[512];
+    uint32_t size = make_pack(buf, sizeof(buf));
+
+    FILE * f = fopen("md_pack_test.pack", "wb");
+    TEST_ASSERT_NOT_NULL(f);
+    TEST_ASSERT_EQUAL_UINT32(size, fwrite(buf, 1, size, f));
+    fclose(f);
+
+    lv_markdown_pack_t * pack = lv_markdown_pack_open("A:md_pack_test.pack");
+    TEST_ASSERT_NOT_NULL(pack);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_markdown_pack_get_count(pack));
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_set_text_from_pack(md, pack, "about"));
+    TEST_ASSERT_EQUAL_STRING(pack_docs[1], lv_markdown_get_text(md));
+
+    uint32_t len = 0;
+    const char * text = lv_markdown_pack_load(pack, (uint32_t)lv_markdown_pack_find(pack, "home"), &len);
+    TEST_ASSERT_EQUAL_STRING(pack_docs[0], text);
+    lv_markdown_pack_unload(pack, text);
+    lv_markdown_pack_close(pack);
+
+    /* A corrupted document fails its hash check; the index still opens */
+    buf[size - 2] ^= 0x20;
+    f = fopen("md_pack_test.pack", "wb");
+    fwrite(buf, 1, size, f);
+    fclose(f);
+
+    pack = lv_markdown_pack_open("A:md_pack_test.pack");
+    TEST_ASSERT_NOT_NULL(pack);
+    uint32_t failed = 0;
+    for(uint32_t i = 0; i < 3; i++) {
+        text = lv_markdown_pack_load(pack, i, NULL);
+        if(text == NULL) failed++;
+        lv_markdown_pack_unload(pack, text);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, failed);
+    lv_markdown_pack_close(pack);
+    remove("md_pack_test.pack");
+
+    lv_obj_delete(md);
+}
+#endif
+
+/* ===== Log Mode Tests ===== */
+
+static const char * log_block_text(lv_obj_t * md, int32_t idx)
+{
+    lv_obj_t * sg = lv_obj_get_child(md, idx);
+    return lv_span_get_text(lv_spangroup_get_child(sg, 0));
+}
+
+static void log_append_lines(lv_obj_t * md, uint32_t first, uint32_t cnt)
+{
+    char line[32];
+    for(uint32_t i = first; i < first + cnt; i++) {
+        snprintf(line, sizeof(line), "line %u\n", (unsigned)i);
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_append(md, line));
+    }
+}
+
+void test_markdown_log_block_limit_drops_oldest(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_log_mode(md, 3, 0);
+
+    log_append_lines(md, 0, 5);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_markdown_get_block_count(md));
+    TEST_ASSERT_EQUAL_STRING("line 2", log_block_text(md, 0));
+    TEST_ASSERT_EQUAL_STRING("line 4", log_block_text(md, 2));
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_style_margin_top(lv_obj_get_child(md, 0), 0));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_log_byte_limit_reclaims_chunks(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    /* "line N\n" is 7 bytes: room for 4 chunks */
+    lv_markdown_set_log_mode(md, 0, 30);
+
+    log_append_lines(md, 0, 10);
+    TEST_ASSERT_EQUAL_UINT32(4, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_STRING("line 6", log_block_text(md, 0));
+    TEST_ASSERT_EQUAL_STRING("line 9", log_block_text(md, 3));
+
+    /* Longer than the whole ring */
+    char big[40];
+    lv_memset(big, 'x', sizeof(big) - 1);
+    big[sizeof(big) - 1] = '\0';
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_markdown_append(md, big));
+    TEST_ASSERT_EQUAL_UINT32(4, lv_obj_get_child_count(md));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_log_restyle_keeps_trimmed_blocks(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_log_mode(md, 4, 0);
+
+    /* One chunk of three blocks, then three single lines: the first chunk
+     * is trimmed by two blocks and stays partly shown */
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_append(md, "a\n\nb\n\nc\n"));
+    log_append_lines(md, 0, 3);
+    TEST_ASSERT_EQUAL_UINT32(4, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_STRING("c", log_block_text(md, 0));
+
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    lv_markdown_set_style(md, &style);
+
+    TEST_ASSERT_EQUAL_UINT32(4, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_STRING("c", log_block_text(md, 0));
+    TEST_ASSERT_EQUAL_STRING("line 2", log_block_text(md, 3));
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_style_margin_top(lv_obj_get_child(md, 0), 0));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_log_trim_keeps_scroll_position(void)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 300, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    lv_obj_set_width(md, LV_PCT(100));
+    lv_markdown_set_log_mode(md, 10, 0);
+
+    log_append_lines(md, 0, 10);
+    lv_obj_update_layout(view);
+    lv_obj_scroll_to_y(view, 60, LV_ANIM_OFF);
+
+    int32_t top = lv_obj_get_scroll_top(view);
+    int32_t dy = lv_obj_get_y(lv_obj_get_child(md, 1)) - lv_obj_get_y(lv_obj_get_child(md, 0));
+    TEST_ASSERT_GREATER_THAN_INT32(0, dy);
+
+    /* Dropping "line 0" moves the view up by its height */
+    log_append_lines(md, 10, 1);
+    TEST_ASSERT_EQUAL_INT32(top - dy, lv_obj_get_scroll_top(view));
+    TEST_ASSERT_EQUAL_STRING("line 1", log_block_text(md, 0));
+
+    lv_obj_delete(view);
+}
+
+void test_markdown_log_trim_measures_new_blocks(void)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 300, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    lv_obj_set_width(md, LV_PCT(100));
+    lv_markdown_set_log_mode(md, 10, 0);
+
+    log_append_lines(md, 0, 10);
+    lv_obj_update_layout(view);
+    lv_obj_scroll_to_y(view, LV_COORD_MAX, LV_ANIM_OFF);
+    TEST_ASSERT_GREATER_THAN_INT32(0, lv_obj_get_scroll_top(view));
+
+    /* One append replaces every block; the survivor was never laid out */
+    char buf[128];
+    int pos = 0;
+    for(int i = 10; i < 20; i++) {
+        pos += snprintf(buf + pos, sizeof(buf) - pos, "line %d\n\n", i);
+    }
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_append(md, buf));
+    TEST_ASSERT_EQUAL_STRING("line 10", log_block_text(md, 0));
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_scroll_top(view));
+
+    lv_obj_delete(view);
+}
+
+void test_markdown_log_set_text_leaves_log_mode(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_markdown_append(md, "x"));
+
+    lv_markdown_set_log_mode(md, 8, 256);
+    log_append_lines(md, 0, 2);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+
+    lv_markdown_set_text(md, "Hello");
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_markdown_append(md, "x"));
+
+    lv_obj_delete(md);
+}
+
+/* ===== Follow Tail Tests ===== */
+
+static lv_obj_t * follow_view_create(lv_obj_t ** md)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 300, 100);
+    *md = lv_markdown_create(view);
+    lv_markdown_set_log_mode(*md, 1000, 0);
+    return view;
+}
+
+void test_markdown_follow_tail_stays_at_bottom(void)
+{
+    lv_obj_t * md;
+    lv_obj_t * view = follow_view_create(&md);
+    lv_markdown_set_follow_tail(md, true);
+    TEST_ASSERT_TRUE(lv_markdown_get_follow_tail(md));
+
+    for(uint32_t i = 0; i < 20; i++) {
+        log_append_lines(md, i, 1);
+        lv_obj_update_layout(view);
+        TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_scroll_bottom(view));
+    }
+    TEST_ASSERT_GREATER_THAN_INT32(0, lv_obj_get_scroll_top(view));
+    TEST_ASSERT_TRUE(lv_markdown_get_follow_tail(md));
+
+    lv_obj_delete(view);
+}
+
+void test_markdown_follow_tail_detaches_on_scroll_up(void)
+{
+    lv_obj_t * md;
+    lv_obj_t * view = follow_view_create(&md);
+    lv_markdown_set_follow_tail(md, true);
+    log_append_lines(md, 0, 20);
+    lv_obj_update_layout(view);
+
+    lv_obj_scroll_to_y(view, 0, LV_ANIM_OFF);
+    TEST_ASSERT_FALSE(lv_markdown_get_follow_tail(md));
+
+    log_append_lines(md, 20, 5);
+    lv_obj_update_layout(view);
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_scroll_top(view));
+
+    /* Back at the bottom: attached again */
+    lv_obj_scroll_by(view, 0, -lv_obj_get_scroll_bottom(view), LV_ANIM_OFF);
+    TEST_ASSERT_TRUE(lv_markdown_get_follow_tail(md));
+    log_append_lines(md, 25, 5);
+    lv_obj_update_layout(view);
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_scroll_bottom(view));
+
+    lv_obj_delete(view);
+}
+
+void test_markdown_follow_tail_with_log_trim(void)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 300, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    lv_markdown_set_log_mode(md, 8, 0);
+    lv_markdown_set_follow_tail(md, true);
+
+    for(uint32_t i = 0; i < 20; i++) {
+        log_append_lines(md, i, 1);
+        lv_obj_update_layout(view);
+        TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_scroll_bottom(view));
+    }
+    TEST_ASSERT_EQUAL_UINT32(8, lv_obj_get_child_count(md));
+    TEST_ASSERT_TRUE(lv_markdown_get_follow_tail(md));
+
+    /* Off: updates leave the view alone */
+    lv_markdown_set_follow_tail(md, false);
+    TEST_ASSERT_FALSE(lv_markdown_get_follow_tail(md));
+    int32_t top = lv_obj_get_scroll_top(view);
+    lv_markdown_append(md, "a\n\nb\n\nc\n");
+    lv_obj_update_layout(view);
+    TEST_ASSERT_LESS_OR_EQUAL_INT32(top, lv_obj_get_scroll_top(view));
+    TEST_ASSERT_GREATER_THAN_INT32(0, lv_obj_get_scroll_bottom(view));
+
+    lv_obj_delete(view);
+}
+
+/* ===== Reference Definition Index Tests ===== */
+
+/** Text of all spans of a block */
+static const char * refs_block_text(lv_obj_t * md, int32_t idx)
+{
+    static char buf[128];
+    lv_obj_t * sg = lv_obj_get_child(md, idx);
+    buf[0] = '\0';
+    for(uint32_t i = 0; i < lv_spangroup_get_span_count(sg); i++) {
+        strncat(buf, lv_span_get_text(lv_spangroup_get_child(sg, (int32_t)i)), sizeof(buf) - strlen(buf) - 1);
+    }
+    return buf;
+}
+
+void test_markdown_refs_definition_rerenders_only_referencing_chunks(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_log_mode(md, 100, 0);
+
+    lv_markdown_append(md, "See [docs] now\n");
+    lv_markdown_append(md, "Plain [line]\n");
+    lv_markdown_append(md, "Also [the docs][DOCS]\n");
+    TEST_ASSERT_EQUAL_STRING("See [docs] now", refs_block_text(md, 0));
+
+    lv_obj_t * plain = lv_obj_get_child(md, 1);
+    lv_markdown_append(md, "[docs]: https://example.com\n");
+
+    /* Definitions render nothing; both references resolve */
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_STRING("See docs now", refs_block_text(md, 0));
+    TEST_ASSERT_EQUAL_STRING("Also the docs", refs_block_text(md, 2));
+    TEST_ASSERT_EQUAL_PTR(plain, lv_obj_get_child(md, 1));
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_style_margin_top(lv_obj_get_child(md, 0), 0));
+
+    /* Later chunks are parsed with the indexed definition */
+    lv_markdown_append(md, "More [Docs]\n");
+    TEST_ASSERT_EQUAL_STRING("More Docs", refs_block_text(md, 3));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_refs_unchanged_definition_rerenders_nothing(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_log_mode(md, 100, 0);
+
+    lv_markdown_append(md, "[a]: /x\n\nGo [a]\n");
+    lv_markdown_append(md, "Back [a]\n");
+    lv_obj_t * first = lv_obj_get_child(md, 0);
+    lv_obj_t * second = lv_obj_get_child(md, 1);
+
+    lv_markdown_append(md, "[a]: /x\n");
+    TEST_ASSERT_EQUAL_PTR(first, lv_obj_get_child(md, 0));
+    TEST_ASSERT_EQUAL_PTR(second, lv_obj_get_child(md, 1));
+
+    /* A definition in fenced code is not a definition */
+    lv_markdown_append(md, "```\n[b]: /y\n```\n");
+    lv_markdown_append(md, "Try [b]\n");
+    TEST_ASSERT_EQUAL_STRING("Try [b]", refs_block_text(md, 3));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_refs_trimmed_definition_is_dropped(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_log_mode(md, 2, 0);
+
+    lv_markdown_append(md, "[x]: /x\n");
+    lv_markdown_append(md, "one [x]\n");
+    lv_markdown_append(md, "two [x]\n");
+    TEST_ASSERT_EQUAL_STRING("two x", refs_block_text(md, 1));
+
+    /* The defining chunk is gone, and with it the definition */
+    lv_markdown_append(md, "three [x]\n");
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_STRING("two [x]", refs_block_text(md, 0));
+    TEST_ASSERT_EQUAL_STRING("three [x]", refs_block_text(md, 1));
+
+    /* A restyle renders the same */
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    lv_markdown_set_style(md, &style);
+    TEST_ASSERT_EQUAL_STRING("two [x]", refs_block_text(md, 0));
+
+    /* Defined again by a shown chunk */
+    lv_markdown_append(md, "[x]: /y\n");
+    TEST_ASSERT_EQUAL_STRING("two x", refs_block_text(md, 0));
+    TEST_ASSERT_EQUAL_STRING("three x", refs_block_text(md, 1));
+
+    lv_obj_delete(md);
+}
+
+/* ===== Scheduler Tests ===== */
+
+void test_markdown_sched_builds_nearest_first(void)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 300, 100);
+    lv_obj_t * near = lv_markdown_create(view);
+    lv_obj_t * far = lv_markdown_create(view);
+    lv_obj_set_y(far, 1000);
+    lv_obj_t * other_screen = lv_obj_create(NULL);
+    lv_obj_t * elsewhere = lv_markdown_create(other_screen);
+    lv_obj_update_layout(view);
+
+    lv_markdown_sched_enable(5);
+    lv_markdown_set_text(elsewhere, "Other screen");
+    lv_markdown_set_text(far, "Far below");
+    lv_markdown_set_text(near, "Visible");
+    TEST_ASSERT_EQUAL_UINT32(3, lv_markdown_sched_get_pending());
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(near));
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_markdown_sched_run(0));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(near));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(far));
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_markdown_sched_run(0));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(far));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(elsewhere));
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_markdown_sched_run(0));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(elsewhere));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_markdown_sched_get_pending());
+
+    lv_markdown_sched_enable(0);
+    lv_obj_delete(other_screen);
+    lv_obj_delete(view);
+}
+
+void test_markdown_sched_queues_once_and_forgets_deleted(void)
+{
+    lv_markdown_sched_enable(5);
+
+    lv_obj_t * a = lv_markdown_create(lv_screen_active());
+    lv_obj_t * b = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(a, "First");
+    lv_markdown_set_text(a, "# Second\n\nText");
+    lv_markdown_set_text(b, "Gone");
+    TEST_ASSERT_EQUAL_UINT32(2, lv_markdown_sched_get_pending());
+
+    lv_obj_delete(b);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_markdown_sched_get_pending());
+
+    lv_markdown_set_text(a, NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_markdown_sched_get_pending());
+
+    /* Turning the scheduler off builds what is left */
+    lv_markdown_set_text(a, "# Second\n\nText");
+    lv_markdown_sched_enable(0);
+    TEST_ASSERT_EQUAL_UINT32(0, lv_markdown_sched_get_pending());
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(a));
+
+    lv_obj_delete(a);
+}
+
+void test_markdown_sched_restyle_keeps_old_tree_until_built(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "One\n\nTwo");
+    lv_obj_t * old_first = lv_obj_get_child(md, 0);
+
+    lv_markdown_sched_enable(5);
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    lv_markdown_set_style(md, &style);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_markdown_sched_get_pending());
+    TEST_ASSERT_EQUAL_PTR(old_first, lv_obj_get_child(md, 0));
+
+    lv_markdown_sched_flush();
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_markdown_get_block_count(md));
+
+    lv_markdown_sched_enable(0);
+    lv_obj_delete(md);
+}
+
+/* ===== View State Tests ===== */
+
+/** Markdown with `n` paragraphs of a few wrapped lines each */
+static const char * state_doc(uint32_t n)
+{
+    static char buf[4096];
+    buf[0] = '\0';
+    for(uint32_t i = 0; i < n; i++) {
+        char para[96];
+        snprintf(para, sizeof(para), "Paragraph %u with enough words to wrap over lines.\n\n", (unsigned)i);
+        strncat(buf, para, sizeof(buf) - strlen(buf) - 1);
+    }
+    return buf;
+}
+
+void test_markdown_state_restore_puts_anchor_back(void)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 150, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    lv_markdown_set_text(md, state_doc(20));
+    lv_obj_update_layout(view);
+    lv_obj_scroll_to_y(view, 240, LV_ANIM_OFF);
+    int32_t scroll_y = lv_obj_get_scroll_y(view);
+
+    lv_markdown_state_t state;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_save_state(md, &state));
+    TEST_ASSERT_EQUAL_UINT32(20, state.block_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, state.anchor_block);
+    lv_obj_delete(view);
+
+    /* Recreated screen: same text, same place, far blocks not wrapped yet */
+    view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 150, 100);
+    md = lv_markdown_create(view);
+    lv_markdown_set_text(md, state_doc(20));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_restore_state(md, &state));
+    TEST_ASSERT_EQUAL_INT32(scroll_y, lv_obj_get_scroll_y(view));
+    lv_obj_t * last = lv_obj_get_child(md, 19);
+    TEST_ASSERT_EQUAL_INT32(state.heights[19], lv_obj_get_style_height(last, 0));
+
+    /* Scrolled into view: released without moving anything */
+    lv_obj_scroll_to_y(view, lv_obj_get_scroll_y(view) + lv_obj_get_scroll_bottom(view), LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL_INT32(LV_SIZE_CONTENT, lv_obj_get_style_height(last, 0));
+    lv_obj_update_layout(view);
+    TEST_ASSERT_EQUAL_INT32(state.heights[19], lv_obj_get_height(last));
+
+    lv_markdown_state_free(&state);
+    TEST_ASSERT_NULL(state.heights);
+    lv_obj_delete(view);
+}
+
+void test_markdown_state_restore_rejects_other_document(void)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 150, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+
+    lv_markdown_state_t state;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_markdown_save_state(md, &state));
+    TEST_ASSERT_NULL(state.heights);
+
+    lv_markdown_set_text(md, state_doc(6));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_save_state(md, &state));
+
+    lv_markdown_set_text(md, state_doc(7));
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_markdown_restore_state(md, &state));
+    for(uint32_t i = 0; i < 7; i++) {
+        TEST_ASSERT_EQUAL_INT32(LV_SIZE_CONTENT, lv_obj_get_style_height(lv_obj_get_child(md, (int32_t)i), 0));
+    }
+
+    lv_markdown_state_free(&state);
+    lv_obj_delete(view);
+}
+
+void test_markdown_state_restore_at_other_width_lays_out_all(void)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 150, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    lv_markdown_set_text(md, state_doc(12));
+    lv_obj_update_layout(view);
+
+    lv_markdown_state_t state;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_save_state(md, &state));
+
+    lv_obj_set_width(view, 250);
+    lv_markdown_set_text(md, state_doc(12));
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_restore_state(md, &state));
+    for(uint32_t i = 0; i < 12; i++) {
+        TEST_ASSERT_EQUAL_INT32(LV_SIZE_CONTENT, lv_obj_get_style_height(lv_obj_get_child(md, (int32_t)i), 0));
+    }
+
+    lv_markdown_state_free(&state);
+    lv_obj_delete(view);
+}
+
+/* ===== Huge Document Tests ===== */
+
+/** `n` one-line paragraphs: 2 lines each */
+static const char * huge_doc(uint32_t n)
+{
+    static char buf[4096];
+    buf[0] = '\0';
+    for(uint32_t i = 0; i < n; i++) {
+        char para[24];
+        snprintf(para, sizeof(para), "Line %u\n\n", (unsigned)i);
+        strncat(buf, para, sizeof(buf) - strlen(buf) - 1);
+    }
+    return buf;
+}
+
+void test_markdown_huge_indexes_and_shows_a_window(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    const char * doc = huge_doc(30);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_markdown_set_text_huge(md, doc, strlen(doc), 4));
+
+    /* A mark every 4 lines, i.e. every other paragraph */
+    TEST_ASSERT_EQUAL_UINT32(60, (uint32_t)lv_markdown_huge_get_line_count(md));
+    TEST_ASSERT_EQUAL_UINT32(15, lv_markdown_huge_get_mark_count(md));
+    TEST_ASSERT_NULL(lv_markdown_get_text(md));
+
+    TEST_ASSERT_EQUAL_UINT32(2 * LV_MARKDOWN_HUGE_WINDOW, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_UINT32(2 * LV_MARKDOWN_HUGE_WINDOW, lv_markdown_get_block_count(md));
+
+    lv_markdown_huge_show_line(md, 21);
+    TEST_ASSERT_EQUAL_UINT32(20, (uint32_t)lv_markdown_huge_get_first_line(md));
+    TEST_ASSERT_EQUAL_INT32(0, lv_obj_get_style_margin_top(lv_obj_get_child(md, 0), 0));
+
+    /* Near the end the window is kept full */
+    lv_markdown_huge_show_line(md, 59);
+    TEST_ASSERT_EQUAL_UINT32(60 - 4 * LV_MARKDOWN_HUGE_WINDOW, (uint32_t)lv_markdown_huge_get_first_line(md));
+    TEST_ASSERT_EQUAL_UINT32(2 * LV_MARKDOWN_HUGE_WINDOW, lv_obj_get_child_count(md));
+
+    lv_markdown_set_text(md, "Back");
+    TEST_ASSERT_EQUAL_UINT32(0, lv_markdown_huge_get_mark_count(md));
+    lv_obj_delete(md);
+}
+
+void test_markdown_huge_does_not_split_fenced_code(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    const char * doc = "A\n\n```\nx\n\ny\n\nz\n```\n\nB\n\nC\n";
+    lv_markdown_set_text_huge(md, doc, strlen(doc), 1);
+
+    /* Sections: A, the code block, B, C */
+    TEST_ASSERT_EQUAL_UINT32(4, lv_markdown_huge_get_mark_count(md));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(md));
+    TEST_ASSERT_FALSE(lv_obj_check_type(lv_obj_get_child(md, 1), &lv_spangroup_class));
+    TEST_ASSERT_TRUE(lv_obj_check_type(lv_obj_get_child(md, 2), &lv_spangroup_class));
+
+    lv_markdown_huge_show_line(md, 12);
+    TEST_ASSERT_EQUAL_UINT32(2, (uint32_t)lv_markdown_huge_get_first_line(md));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_huge_does_not_split_loose_lists_or_html(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+    /* One loose list, then the paragraph */
+    const char * list = "- a\n\n- b\n\n1. c\n\nP\n";
+    lv_markdown_set_text_huge(md, list, strlen(list), 1);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_markdown_huge_get_mark_count(md));
+
+    /* The comment runs to its end marker, across the blank line */
+    const char * html = "<!--\nx\n\ny\n-->\n\nP\n\n<pre>\n\n</pre>\n\nQ\n";
+    lv_markdown_set_text_huge(md, html, strlen(html), 1);
+    TEST_ASSERT_EQUAL_UINT32(4, lv_markdown_huge_get_mark_count(md));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_huge_cuts_long_sections_at_blank_lines(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    static char buf[2 * LV_MARKDOWN_HUGE_SECTION_MAX];
+
+    /* Two paragraphs, the limit falls inside the second: cut before it */
+    buf[0] = '\0';
+    for(int i = 0; i < 60; i++) strcat(buf, "aaaaaaaaaa\n");
+    strcat(buf, "\n");
+    for(int i = 0; i < 60; i++) strcat(buf, "aaaaaaaaaa\n");
+    TEST_ASSERT_GREATER_THAN_UINT32(LV_MARKDOWN_HUGE_SECTION_MAX, (uint32_t)strlen(buf));
+    lv_markdown_set_text_huge(md, buf, strlen(buf), UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_markdown_huge_get_mark_count(md));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+
+    /* A tight list the limit falls into is kept whole */
+    buf[0] = '\0';
+    for(int i = 0; i < 10; i++) strcat(buf, "aaaaaaaaa\n");
+    strcat(buf, "\n");
+    for(int i = 0; i < 140; i++) strcat(buf, "- item\n");
+    TEST_ASSERT_GREATER_THAN_UINT32(LV_MARKDOWN_HUGE_SECTION_MAX, (uint32_t)strlen(buf));
+    lv_markdown_set_text_huge(md, buf, strlen(buf), UINT32_MAX);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_markdown_huge_get_mark_count(md));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_huge_window_slides_with_scrolling(void)
+{
+    lv_obj_t * view = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(view, 300, 100);
+    lv_obj_t * md = lv_markdown_create(view);
+    const char * doc = huge_doc(100);
+    lv_markdown_set_text_huge(md, doc, strlen(doc), 20);
+    uint32_t blocks = lv_obj_get_child_count(md);
+    TEST_ASSERT_EQUAL_UINT32(10 * LV_MARKDOWN_HUGE_WINDOW, blocks);
+
+    /* Stop at the bottom: the next section comes in, the first goes, and
+     * what is shown doesn't move */
+    lv_obj_update_layout(view);
+    lv_obj_t * last = lv_obj_get_child(md, -1);
+    lv_area_t a;
+    lv_obj_get_coords(last, &a);
+    int32_t expected = a.y1 - lv_obj_get_scroll_bottom(view);
+
+    lv_obj_scroll_to_y(view, lv_obj_get_scroll_y(view) + lv_obj_get_scroll_bottom(view), LV_ANIM_OFF);
+    lv_obj_update_layout(view);
+    TEST_ASSERT_EQUAL_UINT32(20, (uint32_t)lv_markdown_huge_get_first_line(md));
+    TEST_ASSERT_EQUAL_UINT32(blocks, lv_obj_get_child_count(md));
+    lv_obj_get_coords(last, &a);
+    TEST_ASSERT_EQUAL_INT32(expected, a.y1);
+
+    /* Stop at the top: back again, still in place */
+    lv_obj_t * top = lv_obj_get_child(md, 0);
+    lv_obj_get_coords(top, &a);
+    expected = a.y1 + lv_obj_get_scroll_y(view);
+
+    lv_obj_scroll_to_y(view, 0, LV_ANIM_OFF);
+    lv_obj_update_layout(view);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)lv_markdown_huge_get_first_line(md));
+    TEST_ASSERT_EQUAL_UINT32(blocks, lv_obj_get_child_count(md));
+    lv_obj_get_coords(top, &a);
+    TEST_ASSERT_EQUAL_INT32(expected, a.y1);
+
+    lv_obj_delete(view);
+}
+
+/* ===== Span Text Arena Tests ===== */
+
+void test_markdown_arena_span_text_is_contiguous(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "- one **two** three\n- four");
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+
+    /* Every span's text follows the previous one's, across blocks */
+    const char * prev = NULL;
+    for(int32_t b = 0; b < 2; b++) {
+        lv_obj_t * sg = lv_obj_get_child(md, b);
+        for(uint32_t i = 0; i < lv_spangroup_get_span_count(sg); i++) {
+            const char * t = lv_span_get_text(lv_spangroup_get_child(sg, (int32_t)i));
+            if(prev != NULL) TEST_ASSERT_EQUAL_PTR(prev + strlen(prev) + 1, t);
+            prev = t;
+        }
+    }
+    TEST_ASSERT_EQUAL_STRING("four", prev);
+
+    /* A rebuild starts a new arena */
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    lv_markdown_set_style(md, &style);
+    TEST_ASSERT_EQUAL_STRING("two", lv_span_get_text(lv_spangroup_get_child(lv_obj_get_child(md, 0), 2)));
+
+    lv_obj_delete(md);
+}
+
+/* ===== UTF-8 Check Tests ===== */
+
+void test_markdown_utf8_scan_finds_invalid_sequences(void)
+{
+    lv_markdown_utf8_result_t res;
+
+    lv_markdown_utf8_scan("plain ascii text, longer than one vector", 40, &res);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)res.invalid);
+    TEST_ASSERT_TRUE(res.ascii);
+
+    lv_markdown_utf8_scan("caf\xC3\xA9 \xF0\x9F\x98\x80", 10, &res);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)res.invalid);
+    TEST_ASSERT_FALSE(res.ascii);
+
+    /* Overlong, surrogate, truncated, stray continuation */
+    lv_markdown_utf8_scan("\xC0\xAF", 2, &res);
+    TEST_ASSERT_EQUAL_UINT32(2, (uint32_t)res.invalid);
+    lv_markdown_utf8_scan("\xED\xA0\x80", 3, &res);
+    TEST_ASSERT_EQUAL_UINT32(3, (uint32_t)res.invalid);
+    lv_markdown_utf8_scan("a\xE2\x82z", 4, &res);
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)res.invalid);
+    lv_markdown_utf8_scan("0123456789abcdef0123456789abcdef\x80", 33, &res);
+    TEST_ASSERT_EQUAL_UINT32(1, (uint32_t)res.invalid);
+}
+
+void test_markdown_utf8_set_text_repairs(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+    lv_markdown_set_text(md, "ok \xC3\xA9");
+    TEST_ASSERT_TRUE(lv_markdown_get_utf8_valid(md));
+
+    lv_markdown_set_text(md, "a\xE2\x82z \xFF");
+    TEST_ASSERT_FALSE(lv_markdown_get_utf8_valid(md));
+    TEST_ASSERT_EQUAL_STRING("a\xEF\xBF\xBDz \xEF\xBF\xBD", lv_markdown_get_text(md));
+
+    /* Check only: the text is kept as it is */
+    lv_markdown_set_utf8_policy(md, LV_MARKDOWN_UTF8_CHECK);
+    lv_markdown_set_text(md, "a\xFF");
+    TEST_ASSERT_FALSE(lv_markdown_get_utf8_valid(md));
+    TEST_ASSERT_EQUAL_STRING("a\xFF", lv_markdown_get_text(md));
+
+    lv_markdown_set_utf8_policy(md, LV_MARKDOWN_UTF8_OFF);
+    lv_markdown_set_text(md, "a\xFF");
+    TEST_ASSERT_TRUE(lv_markdown_get_utf8_valid(md));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_utf8_static_text_repaired_into_copy(void)
+{
+    static const char valid[] = "static **text**";
+    static const char invalid[] = "static \xC0 text";
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+    lv_markdown_set_text_static(md, valid);
+    TEST_ASSERT_EQUAL_PTR(valid, lv_markdown_get_text(md));
+
+    lv_markdown_set_text_static(md, invalid);
+    TEST_ASSERT_TRUE(lv_markdown_get_text(md) != invalid);
+    TEST_ASSERT_EQUAL_STRING("static \xEF\xBF\xBD text", lv_markdown_get_text(md));
+
+    lv_obj_delete(md);
+}
+
+/* ===== Lazy Building Tests ===== */
+
+void test_markdown_lazy_builds_when_shown(void)
+{
+    lv_obj_t * shown = lv_markdown_create(lv_screen_active());
+    lv_obj_t * hidden = lv_markdown_create(lv_screen_active());
+    lv_obj_add_flag(hidden, LV_OBJ_FLAG_HIDDEN);
+    lv_markdown_set_lazy(shown, true);
+    lv_markdown_set_lazy(hidden, true);
+
+    lv_markdown_set_text(shown, "# Shown\n\nText");
+    lv_markdown_set_text(hidden, "Hidden");
+    TEST_ASSERT_FALSE(lv_markdown_is_built(shown));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(shown));
+
+    /* Built before the frame is drawn; the hidden one waits */
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(lv_markdown_is_built(shown));
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(shown));
+    TEST_ASSERT_FALSE(lv_markdown_is_built(hidden));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(hidden));
+
+    lv_obj_remove_flag(hidden, LV_OBJ_FLAG_HIDDEN);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(hidden));
+
+    /* A restyle of a shown widget waits for the next frame too */
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    lv_markdown_set_style(shown, &style);
+    TEST_ASSERT_FALSE(lv_markdown_is_built(shown));
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(lv_markdown_is_built(shown));
+
+    lv_obj_delete(shown);
+    lv_obj_delete(hidden);
+}
+
+void test_markdown_lazy_build_on_request(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_obj_add_flag(md, LV_OBJ_FLAG_HIDDEN);
+    lv_markdown_set_lazy(md, true);
+    TEST_ASSERT_TRUE(lv_markdown_get_lazy(md));
+
+    lv_markdown_set_text(md, "- one\n- two");
+    lv_markdown_build(md);
+    TEST_ASSERT_TRUE(lv_markdown_is_built(md));
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(md));
+
+    /* Turning lazy off builds a waiting widget */
+    lv_markdown_set_text(md, "One\n\nTwo");
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(md));
+    lv_markdown_set_lazy(md, false);
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+
+    /* Deleting a waiting widget drops it from the list */
+    lv_markdown_set_lazy(md, true);
+    lv_markdown_set_text(md, "Never shown");
+    lv_obj_delete(md);
+    lv_refr_now(NULL);
+}
+
+/* ===== Coalescing Tests ===== */
+
+void test_markdown_coalesce_builds_once_per_frame(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_obj_add_flag(md, LV_OBJ_FLAG_HIDDEN);
+    lv_markdown_set_coalesce(md, true);
+    TEST_ASSERT_TRUE(lv_markdown_get_coalesce(md));
+
+    char buf[32];
+    for(int32_t i = 0; i < 5; i++) {
+        snprintf(buf, sizeof(buf), "Reading %d", (int)i);
+        lv_markdown_set_text(md, buf);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(md));
+
+    /* Built at the next frame, even though hidden, with the latest text */
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(md));
+    lv_obj_t * sg = lv_obj_get_child(md, 0);
+    TEST_ASSERT_EQUAL_STRING("Reading 4", lv_span_get_text(lv_spangroup_get_child(sg, 0)));
+
+    lv_markdown_update_stats_t stats;
+    lv_markdown_get_update_stats(md, &stats);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.updates);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.builds);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.coalesced);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.discarded);
+
+    /* Turning it off builds right away again */
+    lv_markdown_set_coalesce(md, false);
+    lv_markdown_set_text(md, "Now");
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(md));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_update_stats_count_unseen_trees(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+    lv_markdown_set_text(md, "One");
+    lv_markdown_set_text(md, "Two");
+    lv_markdown_set_text(md, "Three");
+    lv_refr_now(NULL);
+    lv_markdown_set_text(md, "Four");
+
+    /* "One" and "Two" were never drawn; "Three" was */
+    lv_markdown_update_stats_t stats;
+    lv_markdown_get_update_stats(md, &stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.updates);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.builds);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.coalesced);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.discarded);
+
+    lv_markdown_reset_update_stats(md);
+    lv_markdown_get_update_stats(md, &stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.updates);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.discarded);
+
+    lv_obj_delete(md);
+}
+
+/* ===== Preview Tests ===== */
+
+static const char * last_span_text(lv_obj_t * sg)
+{
+    uint32_t cnt = lv_spangroup_get_span_count(sg);
+    return lv_span_get_text(lv_spangroup_get_child(sg, (int32_t)cnt - 1));
+}
+
+void test_markdown_preview_stops_at_block_limit(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_preview_limits(md, 2, 0);
+    lv_markdown_set_text(md, "# One\n\nTwo\n\nThree\n\nFour");
+
+    TEST_ASSERT_EQUAL_UINT32(2, lv_obj_get_child_count(md));
+    TEST_ASSERT_TRUE(lv_markdown_get_preview_truncated(md));
+    TEST_ASSERT_EQUAL_STRING(LV_MARKDOWN_PREVIEW_ELLIPSIS, last_span_text(lv_obj_get_child(md, 1)));
+
+    /* A document within the limits is shown as it is */
+    lv_markdown_set_text(md, "# One\n\nTwo");
+    TEST_ASSERT_FALSE(lv_markdown_get_preview_truncated(md));
+    TEST_ASSERT_EQUAL_STRING("Two", last_span_text(lv_obj_get_child(md, 1)));
+
+    /* Lifting the limits re-renders the whole text */
+    lv_markdown_set_text(md, "One\n\nTwo\n\nThree");
+    lv_markdown_set_preview_limits(md, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(md));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_preview_cuts_text_with_formatting(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_preview_limits(md, 0, 8);
+    lv_markdown_set_text(md, "Hello **bold** world\n\nNext");
+
+    TEST_ASSERT_EQUAL_UINT32(1, lv_obj_get_child_count(md));
+    lv_obj_t * sg = lv_obj_get_child(md, 0);
+    TEST_ASSERT_EQUAL_UINT32(3, lv_spangroup_get_span_count(sg));
+    TEST_ASSERT_EQUAL_STRING("Hello ", lv_span_get_text(lv_spangroup_get_child(sg, 0)));
+    TEST_ASSERT_EQUAL_STRING("bo", lv_span_get_text(lv_spangroup_get_child(sg, 1)));
+    TEST_ASSERT_EQUAL_STRING(LV_MARKDOWN_PREVIEW_ELLIPSIS, last_span_text(sg));
+
+    /* Characters, not bytes; code blocks get the ellipsis too */
+    lv_markdown_set_text(md, "```\n\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\n```");
+    lv_obj_t * label = lv_obj_get_child(lv_obj_get_child(md, 0), 0);
+    TEST_ASSERT_EQUAL_STRING("\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9" LV_MARKDOWN_PREVIEW_ELLIPSIS,
+                             lv_label_get_text(label));
+
+    lv_obj_delete(md);
+}
+
+void test_markdown_preview_of_long_document(void)
+{
+    /* Far more source than the preview window */
+    size_t len = 64 * 1024;
+    char * doc = (char *)lv_malloc(len + 1);
+    TEST_ASSERT_NOT_NULL(doc);
+    /* Paragraphs of 62 characters */
+    for(size_t i = 0; i < len; i++) doc[i] = (i % 64 >= 62) ? '\n' : 'w';
+    doc[len] = '\0';
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_preview_limits(md, 3, 200);
+    lv_markdown_set_text_static(md, doc);
+
+    TEST_ASSERT_TRUE(lv_markdown_get_preview_truncated(md));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_obj_get_child_count(md));
+    TEST_ASSERT_EQUAL_UINT32(3, lv_markdown_get_block_count(md));
+
+    lv_obj_delete(md);
+    lv_free(doc);
+}
+
+/* ===== Golden Render Tests ===== */
+
+/*
+ * Each corpus document is drawn into test_buf and its pixel hash compared
+ * with tests/golden/render.txt. A document without a golden hash fails the
+ * test, and so does a missing or empty file. Set LV_MARKDOWN_GOLDEN_UPDATE=1
+ * to record all hashes (then commit the file), e.g. after an intended visual
+ * change. Build and draw time and allocations go to render_results.txt,
+ * so results of two builds can be diffed: same hashes, lower numbers.
+ * Hashes depend on the LVGL version and fonts.
+ */
+
+#ifndef GOLDEN_PATH
+#define GOLDEN_PATH     "tests/golden/render.txt"
+#endif
+#ifndef GOLDEN_RESULTS
+#define GOLDEN_RESULTS  "render_results.txt"
+#endif
+#define GOLDEN_NAME_MAX 32
+
+static const struct {
+    const char * name;
+    const char * text;
+} golden_corpus[] = {
+    { "paragraphs", "First paragraph with a few words.\n\nSecond paragraph, long enough to wrap "
+      "across the width of the display at the default body font size.\n\nThird." },
+    { "headings", "# Heading 1\n\n## Heading 2\n\n### Heading 3\n\nBody\n\n#### Heading 4\n\n##### Heading 5\n\n###### Heading 6" },
+    { "emphasis", "Plain **bold** *italic* ***both*** `code` ~~struck~~ and [a link](https://example.com).\n\n"
+      "**Bold with *nested italic* inside** and more text." },
+    { "lists", "- one\n- two\n  - nested\n    - deeper\n- three\n\n1. first\n2. second\n3. third\n\n"
+      "- [ ] todo\n- [x] done" },
+    { "code", "```c\nint main(void)\n{\n    return 0;\n}\n```\n\n    indented code\n\nAfter code." },
+    { "quote_rule", "> Quoted text\n> over two lines\n\n---\n\n> Outer\n>\n> > Inner" },
+    { "mixed", "# Release Notes\n\nThe **2.0** release adds *zoom*, `log mode` and more.\n\n## Changes\n\n"
+      "- Faster layout\n- Smaller spans\n\n> Note: see the docs.\n\n```\nmake test\n```\n" },
+};
+
+#define GOLDEN_DOC_CNT (sizeof(golden_corpus) / sizeof(golden_corpus[0]))
+
+typedef struct {
+    char     name[GOLDEN_NAME_MAX];
+    uint32_t hash;
+} golden_entry_t;
+
+static uint32_t golden_load(golden_entry_t * entries, uint32_t max)
+{
+    FILE * f = fopen(GOLDEN_PATH, "r");
+    if(f == NULL) return 0;
+
+    uint32_t cnt = 0;
+    char line[128];
+    while(cnt < max && fgets(line, sizeof(line), f) != NULL) {
+        unsigned hash;
+        if(line[0] == '#') continue;
+        if(sscanf(line, "%31s %x", entries[cnt].name, &hash) == 2) {
+            entries[cnt].hash = (uint32_t)hash;
+            cnt++;
+        }
+    }
+    fclose(f);
+    return cnt;
+}
+
+static const golden_entry_t * golden_find(const golden_entry_t * entries, uint32_t cnt, const char * name)
+{
+    for(uint32_t i = 0; i < cnt; i++) {
+        if(strcmp(entries[i].name, name) == 0) return &entries[i];
+    }
+    return NULL;
+}
+
+static uint32_t elapsed_us(clock_t t0)
+{
+    return (uint32_t)((double)(clock() - t0) * 1000000.0 / CLOCKS_PER_SEC);
+}
+
+/** Draw the whole screen into test_buf and hash it */
+static uint32_t golden_draw_hash(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(test_disp);
+    return lv_markdown_pack_hash(test_buf, sizeof(test_buf));
+}
+
+void test_markdown_golden_corpus_matches(void)
+{
+    golden_entry_t golden[GOLDEN_DOC_CNT];
+    const char * env = getenv("LV_MARKDOWN_GOLDEN_UPDATE");
+    bool update = env != NULL && env[0] == '1';
+    uint32_t golden_cnt = update ? 0 : golden_load(golden, GOLDEN_DOC_CNT);
+
+    golden_entry_t seen[GOLDEN_DOC_CNT];
+    uint32_t missing = 0;
+    uint32_t mismatched = 0;
+
+    FILE * results = fopen(GOLDEN_RESULTS, "w");
+    if(results != NULL) fprintf(results, "# doc\thash\tgolden\tbuild_us\tdraw_us\tallocs\talloc_bytes\n");
+
+    for(uint32_t i = 0; i < GOLDEN_DOC_CNT; i++) {
+        lv_obj_clean(lv_screen_active());
+        lv_obj_t * md = lv_markdown_create(lv_screen_active());
+
+#if LV_MARKDOWN_USE_ALLOC_STATS
+        lv_markdown_alloc_stats_reset();
+#endif
+        clock_t t0 = clock();
+        lv_markdown_set_text(md, golden_corpus[i].text);
+        lv_obj_update_layout(md);
+        uint32_t build_us = elapsed_us(t0);
+
+        t0 = clock();
+        uint32_t hash = golden_draw_hash();
+        uint32_t draw_us = elapsed_us(t0);
+
+        uint32_t allocs = 0;
+        size_t bytes = 0;
+#if LV_MARKDOWN_USE_ALLOC_STATS
+        for(int ph = 0; ph < LV_MARKDOWN_PHASE_CNT; ph++) {
+            lv_markdown_alloc_stats_t st;
+            lv_markdown_alloc_stats_get((lv_markdown_phase_t)ph, &st);
+            allocs += st.allocs;
+            bytes += st.bytes;
+        }
+#endif
+
+        const golden_entry_t * g = golden_find(golden, golden_cnt, golden_corpus[i].name);
+        const char * status = g == NULL ? (update ? "new" : "MISSING") : (g->hash == hash ? "ok" : "MISMATCH");
+        if(g == NULL) missing++;
+        else if(g->hash != hash) mismatched++;
+
+        snprintf(seen[i].name, sizeof(seen[i].name), "%s", golden_corpus[i].name);
+        seen[i].hash = hash;
+
+        if(results != NULL) {
+            fprintf(results, "%s\t%08x\t%s\t%u\t%u\t%u\t%u\n", golden_corpus[i].name, (unsigned)hash, status,
+                    (unsigned)build_us, (unsigned)draw_us, (unsigned)allocs, (unsigned)bytes);
+        }
+        if(g != NULL && g->hash != hash) {
+            printf("golden: pixels of '%s' changed: %08x, golden %08x\n", golden_corpus[i].name,
+                   (unsigned)hash, (unsigned)g->hash);
+        }
+        else if(g == NULL && !update) {
+            printf("golden: no hash for '%s'\n", golden_corpus[i].name);
+        }
+    }
+    if(results != NULL) fclose(results);
+
+    /* Only an explicit update writes the golden file */
+    if(update) {
+        FILE * f = fopen(GOLDEN_PATH, "w");
+        TEST_ASSERT_NOT_NULL_MESSAGE(f, "cannot write " GOLDEN_PATH);
+        fprintf(f, "# Pixel hashes of the golden render corpus (see test_lv_markdown.c)\n");
+        for(uint32_t i = 0; i < GOLDEN_DOC_CNT; i++) {
+            fprintf(f, "%s %08x\n", seen[i].name, (unsigned)seen[i].hash);
+        }
+        fclose(f);
+        return;
+    }
+
+    if(golden_cnt == 0) {
+        TEST_FAIL_MESSAGE("no hashes in " GOLDEN_PATH ", record them with LV_MARKDOWN_GOLDEN_UPDATE=1");
+    }
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, missing, "documents without a hash in " GOLDEN_PATH);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, mismatched, "rendered pixels differ from " GOLDEN_PATH);
+}
+
+void test_markdown_golden_hash_covers_pixels(void)
+{
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_markdown_set_text(md, "Same text");
+    uint32_t a = golden_draw_hash();
+    TEST_ASSERT_EQUAL_HEX32(a, golden_draw_hash());
+
+    lv_markdown_style_t style;
+    lv_markdown_style_init(&style);
+    style.body_color = lv_color_hex(0xff0000);
+    lv_markdown_set_style(md, &style);
+    TEST_ASSERT_NOT_EQUAL(a, golden_draw_hash());
+
+    lv_obj_delete(md);
+}
+
 /* ===== Unity test runner ===== */
 
 int main(void)
 {
     UNITY_BEGIN();
-
     /* Creation */
     RUN_TEST(test_markdown_create_returns_valid_obj);
     RUN_TEST(test_markdown_create_starts_with_no_children);
@@ -1492,6 +3778,12 @@ int main(void)
     RUN_TEST(test_markdown_list_item_no_indent_on_regular_paragraph);
     RUN_TEST(test_markdown_paragraph_after_list_no_indent);
 
+    /* Task lists + strikethrough */
+    RUN_TEST(test_markdown_tasklist_glyph_prefix);
+    RUN_TEST(test_markdown_tasklist_custom_glyph_loose_list);
+    RUN_TEST(test_markdown_tasklist_costs_no_more_objects_than_list);
+    RUN_TEST(test_markdown_strikethrough_decor);
+
     /* Code blocks */
     RUN_TEST(test_markdown_code_block_creates_child);
     RUN_TEST(test_markdown_code_block_block_count);
@@ -1549,5 +3841,142 @@ int main(void)
     RUN_TEST(test_markdown_set_text_null_obj_data);
     RUN_TEST(test_markdown_set_text_static_null_clears);
 
+    /* Draw profiles */
+    RUN_TEST(test_markdown_draw_profile_default);
+    RUN_TEST(test_markdown_low_cost_italic_uses_color);
+    RUN_TEST(test_markdown_low_cost_bold_uses_color);
+    RUN_TEST(test_markdown_low_cost_square_code_block);
+    RUN_TEST(test_markdown_low_cost_solid_blockquote_border);
+
+    /* Compact messages */
+    RUN_TEST(test_markdown_msg_plain_text_is_single_label);
+    RUN_TEST(test_markdown_msg_formatted_text_renders_blocks);
+    RUN_TEST(test_markdown_msg_multi_block);
+    RUN_TEST(test_markdown_msg_uses_shared_style);
+    RUN_TEST(test_markdown_msg_data_size_is_small);
+    RUN_TEST(test_markdown_msg_set_text_null_clears);
+
+    /* Zoom */
+    RUN_TEST(test_markdown_zoom_swaps_fonts_in_place);
+    RUN_TEST(test_markdown_zoom_maps_span_fonts);
+    RUN_TEST(test_markdown_zoom_defers_offscreen_blocks);
+    RUN_TEST(test_markdown_zoom_keeps_pinned_blocks_pinned);
+    RUN_TEST(test_markdown_zoom_follows_log_trims);
+    RUN_TEST(test_markdown_zoom_scale_sets_transform);
+    RUN_TEST(test_markdown_set_style_turns_zoom_off);
+
+    /* Block handler registry */
+    RUN_TEST(test_markdown_handler_by_fence_language);
+    RUN_TEST(test_markdown_handler_long_and_missing_language);
+    RUN_TEST(test_markdown_handler_hr_merged_into_previous);
+    RUN_TEST(test_markdown_handler_lazy_builds_on_draw);
+    RUN_TEST(test_markdown_handler_lazy_deleted_before_build);
+
+    /* Document packs */
+    RUN_TEST(test_markdown_pack_array_loads_in_place);
+    RUN_TEST(test_markdown_pack_rejects_malformed);
+    RUN_TEST(test_markdown_pack_array_sets_text_static);
+#if LV_USE_FS_STDIO
+    RUN_TEST(test_markdown_pack_file_loads_on_demand);
+#endif
+
+    /* Log mode */
+    RUN_TEST(test_markdown_log_block_limit_drops_oldest);
+    RUN_TEST(test_markdown_log_byte_limit_reclaims_chunks);
+    RUN_TEST(test_markdown_log_restyle_keeps_trimmed_blocks);
+    RUN_TEST(test_markdown_log_trim_keeps_scroll_position);
+    RUN_TEST(test_markdown_log_trim_measures_new_blocks);
+    RUN_TEST(test_markdown_log_set_text_leaves_log_mode);
+
+    /* Follow tail */
+    RUN_TEST(test_markdown_follow_tail_stays_at_bottom);
+    RUN_TEST(test_markdown_follow_tail_detaches_on_scroll_up);
+    RUN_TEST(test_markdown_follow_tail_with_log_trim);
+
+    /* Reference definition index */
+    RUN_TEST(test_markdown_refs_definition_rerenders_only_referencing_chunks);
+    RUN_TEST(test_markdown_refs_unchanged_definition_rerenders_nothing);
+    RUN_TEST(test_markdown_refs_trimmed_definition_is_dropped);
+
+    /* Scheduler */
+    RUN_TEST(test_markdown_sched_builds_nearest_first);
+    RUN_TEST(test_markdown_sched_queues_once_and_forgets_deleted);
+    RUN_TEST(test_markdown_sched_restyle_keeps_old_tree_until_built);
+
+    /* View state */
+    RUN_TEST(test_markdown_state_restore_puts_anchor_back);
+    RUN_TEST(test_markdown_state_restore_rejects_other_document);
+    RUN_TEST(test_markdown_state_restore_at_other_width_lays_out_all);
+
+    /* Huge documents */
+    RUN_TEST(test_markdown_huge_indexes_and_shows_a_window);
+    RUN_TEST(test_markdown_huge_does_not_split_fenced_code);
+    RUN_TEST(test_markdown_huge_does_not_split_loose_lists_or_html);
+    RUN_TEST(test_markdown_huge_cuts_long_sections_at_blank_lines);
+    RUN_TEST(test_markdown_huge_window_slides_with_scrolling);
+
+    /* Span text arena */
+    RUN_TEST(test_markdown_arena_span_text_is_contiguous);
+
+    /* UTF-8 check */
+    RUN_TEST(test_markdown_utf8_scan_finds_invalid_sequences);
+    RUN_TEST(test_markdown_utf8_set_text_repairs);
+    RUN_TEST(test_markdown_utf8_static_text_repaired_into_copy);
+
+    /* Lazy building */
+    RUN_TEST(test_markdown_lazy_builds_when_shown);
+    RUN_TEST(test_markdown_lazy_build_on_request);
+
+    /* Coalescing */
+    RUN_TEST(test_markdown_coalesce_builds_once_per_frame);
+    RUN_TEST(test_markdown_update_stats_count_unseen_trees);
+
+    /* Preview */
+    RUN_TEST(test_markdown_preview_stops_at_block_limit);
+    RUN_TEST(test_markdown_preview_cuts_text_with_formatting);
+    RUN_TEST(test_markdown_preview_of_long_document);
+
+    /* Golden renders */
+    RUN_TEST(test_markdown_golden_corpus_matches);
+    RUN_TEST(test_markdown_golden_hash_covers_pixels);
+
+#if LV_MARKDOWN_USE_ALLOC_STATS
+    /* Allocation budgets */
+    RUN_TEST(test_markdown_alloc_rerender_within_budget);
+    RUN_TEST(test_markdown_alloc_rerender_not_costlier_than_render);
+    RUN_TEST(test_markdown_alloc_no_leak_across_updates);
+    RUN_TEST(test_markdown_alloc_plain_msg_skips_parser);
+#endif
+
+#if LV_MARKDOWN_USE_TRACE && defined(LV_MARKDOWN_TRACE_CHROME)
+    /* Trace hooks */
+    RUN_TEST(test_markdown_trace_writes_balanced_chrome_json);
+    RUN_TEST(test_markdown_trace_closed_writer_drops_events);
+#endif
+
+#if LV_USE_BIDI
+    /* Bidi cache */
+    RUN_TEST(test_markdown_bidi_cache_reuses_runs);
+    RUN_TEST(test_markdown_bidi_cache_keys_on_direction);
+    RUN_TEST(test_markdown_bidi_hook_only_on_non_ascii_blocks);
+    RUN_TEST(test_markdown_bidi_cache_survives_relayout);
+    RUN_TEST(test_markdown_bidi_cache_flushes_when_full);
+    RUN_TEST(test_markdown_bidi_cache_flushes_on_width_change);
+#endif
+
+#if LV_USE_SNAPSHOT
+    /* Batch renderer */
+    RUN_TEST(test_markdown_batch_renders_into_one_buffer);
+    RUN_TEST(test_markdown_batch_renders_with_scheduler_on);
+    RUN_TEST(test_markdown_batch_render_list);
+    RUN_TEST(test_markdown_batch_does_not_touch_active_screen);
+#endif
+
+#if LV_USE_IMAGE
+    /* Pre-rendered documents */
+    RUN_TEST(test_markdown_prerendered_places_blocks);
+    RUN_TEST(test_markdown_prerendered_null_doc_is_empty);
+#endif
+
     return UNITY_END();
 }
@@ -0,0 +1,238 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file md_pack.c
+ * @brief Host tool: bundle markdown documents into an indexed pack
+ *
+ * Writes the layout described in lv_markdown_pack_format.h, to be opened
+ * with lv_markdown_pack_open (file) or lv_markdown_pack_open_array (C array).
+ *
+ * Usage:
+ *   md_pack [options] -o out id=file.md [id=file.md ...]
+ *
+ * Options:
+ *   -o <file>      output file (required)
+ *   -c <symbol>    write a C file defining `const uint8_t symbol[]` and
+ *                  `const uint32_t symbol_size` instead of a binary pack
+ *
+ * Needs only the C library; builds with `make pack`.
+ */
+
+#include "lv_markdown_pack_format.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char * id;
+    uint32_t     id_len;
+    uint32_t     id_hash;
+    char *       text;
+    uint32_t     len;
+} pack_doc_t;
+
+static char * read_file(const char * path, uint32_t * len)
+{
+    FILE * f = fopen(path, "rb");
+    if(f == NULL) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if(n < 0 || (unsigned long)n >= UINT32_MAX) {
+        fclose(f);
+        return NULL;
+    }
+
+    char * buf = malloc((size_t)n + 1);
+    if(buf != NULL && fread(buf, 1, (size_t)n, f) != (size_t)n) {
+        free(buf);
+        buf = NULL;
+    }
+    if(buf != NULL) {
+        buf[n] = '\0';
+        *len = (uint32_t)n;
+    }
+    fclose(f);
+    return buf;
+}
+
+static int cmp_doc(const void * a, const void * b)
+{
+    const pack_doc_t * x = a;
+    const pack_doc_t * y = b;
+    if(x->id_hash != y->id_hash) return x->id_hash < y->id_hash ? -1 : 1;
+    return strcmp(x->id, y->id);
+}
+
+static void wr16(uint8_t * p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void wr32(uint8_t * p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * Lay out the whole pack in memory. Documents must be sorted.
+ */
+static uint8_t * build_pack(const pack_doc_t * docs, uint32_t cnt, uint32_t * out_size)
+{
+    uint64_t names_size = 0;
+    uint64_t docs_size = 0;
+    for(uint32_t i = 0; i < cnt; i++) {
+        names_size += docs[i].id_len + 1;
+        docs_size += (uint64_t)docs[i].len + 1;
+    }
+
+    uint64_t names_off = LV_MARKDOWN_PACK_HEADER_SIZE + (uint64_t)cnt * LV_MARKDOWN_PACK_ENTRY_SIZE;
+    uint64_t size = names_off + names_size + docs_size;
+    if(size >= UINT32_MAX) return NULL;
+
+    uint8_t * pack = calloc(1, (size_t)size);
+    if(pack == NULL) return NULL;
+
+    memcpy(pack, LV_MARKDOWN_PACK_MAGIC, 4);
+    wr16(pack + 4, LV_MARKDOWN_PACK_VERSION);
+    wr16(pack + 6, LV_MARKDOWN_PACK_ENTRY_SIZE);
+    wr32(pack + 8, cnt);
+    wr32(pack + 12, (uint32_t)names_size);
+
+    uint32_t id_off = 0;
+    uint32_t doc_off = (uint32_t)(names_off + names_size);
+    for(uint32_t i = 0; i < cnt; i++) {
+        uint8_t * e = pack + LV_MARKDOWN_PACK_HEADER_SIZE + (size_t)i * LV_MARKDOWN_PACK_ENTRY_SIZE;
+        wr32(e + 0, docs[i].id_hash);
+        wr32(e + 4, id_off);
+        wr16(e + 8, docs[i].id_len);
+        e[10] = LV_MARKDOWN_PACK_FORMAT_TEXT;
+        e[11] = 0;
+        wr32(e + 12, doc_off);
+        wr32(e + 16, docs[i].len);
+        wr32(e + 20, lv_markdown_pack_hash(docs[i].text, docs[i].len));
+
+        memcpy(pack + names_off + id_off, docs[i].id, docs[i].id_len + 1);
+        memcpy(pack + doc_off, docs[i].text, (size_t)docs[i].len + 1);
+        id_off += docs[i].id_len + 1;
+        doc_off += docs[i].len + 1;
+    }
+
+    *out_size = (uint32_t)size;
+    return pack;
+}
+
+static int write_c(FILE * out, const char * sym, const uint8_t * pack, uint32_t size)
+{
+    fprintf(out, "/* Generated by md_pack. Do not edit. */\n\n");
+    fprintf(out, "#include <stdint.h>\n\n");
+    fprintf(out, "const uint8_t %s[] = {", sym);
+    for(uint32_t i = 0; i < size; i++) {
+        if(i % 16 == 0) fprintf(out, "\n   ");
+        fprintf(out, " 0x%02x,", pack[i]);
+    }
+    fprintf(out, "\n};\n\n");
+    fprintf(out, "const uint32_t %s_size = %u;\n", sym, (unsigned)size);
+    return ferror(out) == 0;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: md_pack [-c symbol] -o out id=file.md [id=file.md ...]\n");
+}
+
+int main(int argc, char ** argv)
+{
+    const char * out_path = NULL;
+    const char * c_sym = NULL;
+
+    int i = 1;
+    for(; i < argc && argv[i][0] == '-'; i++) {
+        if(i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        if(strcmp(argv[i], "-o") == 0) out_path = argv[++i];
+        else if(strcmp(argv[i], "-c") == 0) c_sym = argv[++i];
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if(out_path == NULL || i >= argc) {
+        usage();
+        return 2;
+    }
+
+    uint32_t cnt = (uint32_t)(argc - i);
+    pack_doc_t * docs = calloc(cnt, sizeof(pack_doc_t));
+    if(docs == NULL) return 1;
+
+    int rc = 0;
+    for(uint32_t d = 0; d < cnt && rc == 0; d++) {
+        char * arg = argv[i + (int)d];
+        char * eq = strchr(arg, '=');
+        if(eq == NULL || eq == arg || eq - arg > UINT16_MAX) {
+            usage();
+            rc = 2;
+            break;
+        }
+        *eq = '\0';
+        docs[d].id      = arg;
+        docs[d].id_len  = (uint32_t)(eq - arg);
+        docs[d].id_hash = lv_markdown_pack_hash(arg, docs[d].id_len);
+        docs[d].text    = read_file(eq + 1, &docs[d].len);
+        if(docs[d].text == NULL) {
+            fprintf(stderr, "md_pack: cannot read %s\n", eq + 1);
+            rc = 1;
+        }
+    }
+
+    if(rc == 0) {
+        qsort(docs, cnt, sizeof(pack_doc_t), cmp_doc);
+        for(uint32_t d = 1; d < cnt; d++) {
+            if(strcmp(docs[d - 1].id, docs[d].id) == 0) {
+                fprintf(stderr, "md_pack: duplicate id '%s'\n", docs[d].id);
+                rc = 2;
+                break;
+            }
+        }
+    }
+
+    uint32_t size = 0;
+    uint8_t * pack = NULL;
+    if(rc == 0) {
+        pack = build_pack(docs, cnt, &size);
+        if(pack == NULL) {
+            fprintf(stderr, "md_pack: pack too large or out of memory\n");
+            rc = 1;
+        }
+    }
+
+    if(rc == 0) {
+        FILE * out = fopen(out_path, c_sym != NULL ? "w" : "wb");
+        if(out == NULL) {
+            fprintf(stderr, "md_pack: cannot write %s\n", out_path);
+            rc = 1;
+        }
+        else {
+            int ok = c_sym != NULL ? write_c(out, c_sym, pack, size) : fwrite(pack, 1, size, out) == size;
+            if(fclose(out) != 0 || !ok) {
+                fprintf(stderr, "md_pack: error writing %s\n", out_path);
+                remove(out_path);
+                rc = 1;
+            }
+        }
+    }
+
+    free(pack);
+    for(uint32_t d = 0; d < cnt; d++) free(docs[d].text);
+    free(docs);
+    return rc;
+}
@@ -0,0 +1,290 @@
+/* SPDX-License-Identifier: MIT */
+
+/**
+ * @file md_prerender.c
+ * @brief Host tool: rasterize static markdown documents into C arrays
+ *
+ * Renders each document headlessly with lv_markdown and writes a C file
+ * with the pixels and an lv_markdown_prerendered_t per document, to be
+ * shown with lv_markdown_prerendered_create().
+ *
+ * Usage:
+ *   md_prerender [options] -o out.c name=file.md [name=file.md ...]
+ *
+ * Options:
+ *   -w <px>        document width (default 480)
+ *   -f <format>    rgb565 | xrgb8888 | argb8888 (default argb8888)
+ *   -b <rrggbb>    background color, used by opaque formats (default ffffff)
+ *   -B             one image per top-level block instead of per document
+ *   -o <file>      output C file (required)
+ *
+ * The production style comes from md_prerender_style(); link your own
+ * definition with `make prerender PRERENDER_STYLE=path/to/style.c` so the
+ * images use the same fonts as the device.
+ */
+
+#include "lvgl.h"
+#include "lv_markdown.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* --- Production style hook --- */
+
+#ifndef MD_PRERENDER_HAS_STYLE
+/** Fill in the style to render with. Default: lv_markdown_style_init. */
+void md_prerender_style(lv_markdown_style_t * style);
+
+void md_prerender_style(lv_markdown_style_t * style)
+{
+    lv_markdown_style_init(style);
+}
+#endif
+
+/* --- Options --- */
+
+typedef struct {
+    int32_t           width;
+    lv_color_format_t cf;
+    const char *      cf_name;
+    lv_color_t        bg;
+    int               per_block;
+    const char *      out_path;
+} prerender_opts_t;
+
+static int parse_format(const char * s, prerender_opts_t * o)
+{
+    if(strcmp(s, "rgb565") == 0) {
+        o->cf = LV_COLOR_FORMAT_RGB565;
+        o->cf_name = "LV_COLOR_FORMAT_RGB565";
+    }
+    else if(strcmp(s, "xrgb8888") == 0) {
+        o->cf = LV_COLOR_FORMAT_XRGB8888;
+        o->cf_name = "LV_COLOR_FORMAT_XRGB8888";
+    }
+    else if(strcmp(s, "argb8888") == 0) {
+        o->cf = LV_COLOR_FORMAT_ARGB8888;
+        o->cf_name = "LV_COLOR_FORMAT_ARGB8888";
+    }
+    else {
+        return 0;
+    }
+    return 1;
+}
+
+static int is_opaque(const prerender_opts_t * o)
+{
+    return o->cf != LV_COLOR_FORMAT_ARGB8888;
+}
+
+/* --- Helpers --- */
+
+static char * read_file(const char * path)
+{
+    FILE * f = fopen(path, "rb");
+    if(f == NULL) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if(len < 0) {
+        fclose(f);
+        return NULL;
+    }
+
+    char * buf = malloc((size_t)len + 1);
+    if(buf != NULL && fread(buf, 1, (size_t)len, f) != (size_t)len) {
+        free(buf);
+        buf = NULL;
+    }
+    if(buf != NULL) buf[len] = '\0';
+    fclose(f);
+    return buf;
+}
+
+/**
+ * Write one snapshot as a pixel array plus its lv_image_dsc_t.
+ */
+static void emit_image(FILE * out, const char * sym, const lv_draw_buf_t * buf, const prerender_opts_t * o)
+{
+    fprintf(out, "static const uint8_t %s_map[] = {", sym);
+    for(uint32_t i = 0; i < buf->data_size; i++) {
+        if(i % 16 == 0) fprintf(out, "\n   ");
+        fprintf(out, " 0x%02x,", buf->data[i]);
+    }
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "static const lv_image_dsc_t %s = {\n", sym);
+    fprintf(out, "    .header.magic = LV_IMAGE_HEADER_MAGIC,\n");
+    fprintf(out, "    .header.cf = %s,\n", o->cf_name);
+    fprintf(out, "    .header.w = %u,\n", (unsigned)buf->header.w);
+    fprintf(out, "    .header.h = %u,\n", (unsigned)buf->header.h);
+    fprintf(out, "    .header.stride = %u,\n", (unsigned)buf->header.stride);
+    fprintf(out, "    .data_size = sizeof(%s_map),\n", sym);
+    fprintf(out, "    .data = %s_map,\n", sym);
+    fprintf(out, "};\n\n");
+}
+
+/**
+ * Render one document and emit its images and descriptor.
+ */
+static int prerender_doc(FILE * out, lv_obj_t * md, const char * name, const char * path,
+                         const prerender_opts_t * o)
+{
+    char * text = read_file(path);
+    if(text == NULL) {
+        fprintf(stderr, "md_prerender: cannot read %s\n", path);
+        return 0;
+    }
+
+    lv_markdown_set_text(md, text);
+    free(text);
+    lv_markdown_build(md);
+    lv_obj_update_layout(md);
+
+    int32_t doc_w = lv_obj_get_width(md);
+    int32_t doc_h = lv_obj_get_height(md);
+    uint32_t cnt = o->per_block ? lv_obj_get_child_count(md) : 1;
+    char sym[160];
+
+    for(uint32_t i = 0; i < cnt; i++) {
+        lv_obj_t * target = o->per_block ? lv_obj_get_child(md, (int32_t)i) : md;
+
+        /* Opaque formats have no alpha: blocks without their own background get the page color */
+        int filled = 0;
+        if(is_opaque(o) && lv_obj_get_style_bg_opa(target, 0) == LV_OPA_TRANSP) {
+            lv_obj_set_style_bg_color(target, o->bg, 0);
+            lv_obj_set_style_bg_opa(target, LV_OPA_COVER, 0);
+            filled = 1;
+        }
+
+        lv_draw_buf_t * buf = lv_snapshot_take(target, o->cf);
+        if(filled) lv_obj_set_style_bg_opa(target, LV_OPA_TRANSP, 0);
+        if(buf == NULL) {
+            fprintf(stderr, "md_prerender: snapshot failed for %s\n", name);
+            return 0;
+        }
+
+        snprintf(sym, sizeof(sym), "%s_img%u", name, (unsigned)i);
+        emit_image(out, sym, buf, o);
+        lv_draw_buf_destroy(buf);
+    }
+
+    fprintf(out, "static const lv_markdown_prerendered_block_t %s_blocks[] = {\n", name);
+    for(uint32_t i = 0; i < cnt; i++) {
+        int32_t x = 0;
+        int32_t y = 0;
+        if(o->per_block) {
+            lv_obj_t * child = lv_obj_get_child(md, (int32_t)i);
+            x = lv_obj_get_x(child);
+            y = lv_obj_get_y(child);
+        }
+        fprintf(out, "    { %d, %d, &%s_img%u },\n", (int)x, (int)y, name, (unsigned)i);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "const lv_markdown_prerendered_t %s = { %d, %d, %u, %s_blocks };\n\n",
+            name, (int)doc_w, (int)doc_h, (unsigned)cnt, name);
+    return 1;
+}
+
+static int is_c_identifier(const char * s)
+{
+    if(*s == '\0' || (*s >= '0' && *s <= '9')) return 0;
+    for(; *s; s++) {
+        char c = *s;
+        if(!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_')) return 0;
+    }
+    return 1;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: md_prerender [-w px] [-f rgb565|xrgb8888|argb8888] [-b rrggbb] [-B]\n"
+            "                    -o out.c name=file.md [name=file.md ...]\n");
+}
+
+int main(int argc, char ** argv)
+{
+    prerender_opts_t o = {
+        .width     = 480,
+        .cf        = LV_COLOR_FORMAT_ARGB8888,
+        .cf_name   = "LV_COLOR_FORMAT_ARGB8888",
+        .bg        = lv_color_white(),
+        .per_block = 0,
+        .out_path  = NULL,
+    };
+
+    int i = 1;
+    for(; i < argc && argv[i][0] == '-'; i++) {
+        const char * opt = argv[i];
+        if(strcmp(opt, "-B") == 0) {
+            o.per_block = 1;
+            continue;
+        }
+        if(i + 1 >= argc) {
+            usage();
+            return 2;
+        }
+        const char * val = argv[++i];
+        if(strcmp(opt, "-w") == 0) o.width = atoi(val);
+        else if(strcmp(opt, "-o") == 0) o.out_path = val;
+        else if(strcmp(opt, "-b") == 0) o.bg = lv_color_hex((uint32_t)strtoul(val, NULL, 16));
+        else if(strcmp(opt, "-f") != 0 || !parse_format(val, &o)) {
+            usage();
+            return 2;
+        }
+    }
+    if(o.out_path == NULL || i >= argc || o.width <= 0) {
+        usage();
+        return 2;
+    }
+
+    /* Headless: a display without buffers, never refreshed */
+    lv_init();
+    lv_display_t * disp = lv_display_create(o.width, 4096);
+    lv_display_delete_refr_timer(disp);
+
+    lv_markdown_style_t style;
+    md_prerender_style(&style);
+
+    lv_obj_t * md = lv_markdown_create(lv_screen_active());
+    lv_obj_set_width(md, o.width);
+    lv_markdown_set_style(md, &style);
+
+    FILE * out = fopen(o.out_path, "w");
+    if(out == NULL) {
+        fprintf(stderr, "md_prerender: cannot write %s\n", o.out_path);
+        return 1;
+    }
+    fprintf(out, "/* Generated by md_prerender. Do not edit. */\n\n");
+    fprintf(out, "#include \"lv_markdown.h\"\n\n");
+
+    int rc = 0;
+    for(; i < argc; i++) {
+        char * eq = strchr(argv[i], '=');
+        if(eq == NULL) {
+            usage();
+            rc = 2;
+            break;
+        }
+        *eq = '\0';
+        if(!is_c_identifier(argv[i])) {
+            fprintf(stderr, "md_prerender: '%s' is not a valid C identifier\n", argv[i]);
+            rc = 2;
+            break;
+        }
+        if(!prerender_doc(out, md, argv[i], eq + 1, &o)) {
+            rc = 1;
+            break;
+        }
+    }
+
+    fclose(out);
+    if(rc != 0) remove(o.out_path);
+
+    lv_deinit();
+    return rc;
+}